@@ -0,0 +1,248 @@
+/*--------------------------------------------------------------------------------------------------*/
+/*      Autor: Georgios Terzoglou                                                                   */
+/*      Copyright (©) 2014 by Georgios Terzoglou                                                    */
+/*      Bug-reports and suggestions to georgios.terzoglou@googlemail.com                            */
+/*                                                                                                  */
+/*      GENERAL NOTE: I assume no liability for any damages with this header.                       */
+/*      Using this header at your own risk.                                                         */
+/*                                                                                                  */
+/*      Template class: iConcurrentVector<T, FIRST>                                                 */
+/*                                                                                                  */
+/*      An append-only vector for many producer threads. The elements live in buckets of FIRST,     */
+/*      2 * FIRST, 4 * FIRST, ... elements which are never moved, so references stay valid while    */
+/*      other threads append. push_back, emplace_back and grow_by claim their slots with one        */
+/*      atomic fetch-add on the size, without a lock. A slot is published once its element is       */
+/*      constructed; published elements can be read with operator[] while others append.            */
+/*      flatten() copies the elements into a contiguous iVector once the producers are done.        */
+/*--------------------------------------------------------------------------------------------------*/
+
+#ifndef ICONCURRENTVECTOR_H
+#define ICONCURRENTVECTOR_H
+
+#include "ivector.h"
+
+#include <atomic>
+
+namespace GT
+{
+	template<class T, size_t FIRST = 64> class iConcurrentVector
+	{
+		static_assert(FIRST != 0 && (FIRST & (FIRST - 1)) == 0, "the first bucket size of iConcurrentVector must be a power of two");
+
+		private:
+		// Attributes
+			static const size_t BUCKETS = 8 * sizeof(size_t);
+
+			/* Bucket b holds FIRST << b elements, followed by one state byte per element
+			 * (0 = claimed, 1 = published). Buckets are created on demand and never moved. */
+			std::atomic<T *> buckets[BUCKETS];
+			std::atomic<size_t> claimed;	// slots handed out, published or not
+
+		// Private methods
+			/* Returns the bucket of index, the offset in it through offset */
+			static inline size_t locate(const size_t index, size_t &offset)
+			{
+				const size_t j = index + FIRST, b = floor_log2(j) - floor_log2(FIRST);
+				offset = j - (FIRST << b);
+				return b;
+			}
+
+			static inline size_t floor_log2(const size_t x)
+			{
+            #if defined(__GNUC__) || defined(__clang__)
+				return 8 * sizeof(unsigned long long) - 1 - size_t(__builtin_clzll(x));
+            #else
+				size_t l = 0;
+				while((x >> l) > 1) l++;
+				return l;
+            #endif
+			}
+
+			static inline size_t bucket_size(const size_t b){return FIRST << b;}
+
+			/* Returns the state bytes of bucket b at p */
+			static inline std::atomic<unsigned char> *states(T *p, const size_t b)
+			{
+				return reinterpret_cast<std::atomic<unsigned char> *>(reinterpret_cast<unsigned char *>(p) + sizeof(T) * bucket_size(b));
+			}
+
+			/* Returns bucket b, creates it if it is missing. Null if out of memory. */
+			inline T *bucket(const size_t b);
+
+			/* Claims count slots and constructs them with make(p, i), returns the first index or npos */
+			template<class Make> inline size_t claim(const size_t count, Make make);
+
+		public:
+			static const size_t npos = ~size_t(0);
+
+		// Constructors
+			inline iConcurrentVector(void): claimed(0)
+			{
+				for(size_t b=0; b<BUCKETS; b++) this->buckets[b].store(null_ptr, std::memory_order_relaxed);
+			}
+
+			iConcurrentVector(const iConcurrentVector<T, FIRST> &) = delete;
+			iConcurrentVector<T, FIRST> &operator=(const iConcurrentVector<T, FIRST> &) = delete;
+
+		// Destructor
+			~iConcurrentVector(){this->clear(); this->shrink_to_fit();}
+
+		// Methods
+			/* Appends x, returns its index. Thread safe and lock free except for the creation of a
+			 * bucket. Returns npos if out of memory. */
+			inline size_t push_back(const T &x){return this->emplace_back(x);}
+			inline size_t push_back(T &&x){return this->emplace_back(std::move(x));}
+
+			/* Constructs an element with args at the end, returns its index like push_back. */
+			template<class... Args> inline size_t emplace_back(Args&&... args)
+			{
+				return this->claim(1, [&](T *p, size_t){::new(static_cast<void *>(p)) T(std::forward<Args>(args)...);});
+			}
+
+			/* Claims n consecutive indices at once and value-initializes (copies x into) them.
+			 * Returns the first index, npos if out of memory. */
+			inline size_t grow_by(const size_t n){return this->claim(n, [](T *p, size_t){::new(static_cast<void *>(p)) T();});}
+			inline size_t grow_by(const size_t n, const T &x){return this->claim(n, [&](T *p, size_t){::new(static_cast<void *>(p)) T(x);});}
+
+			/* Returns the element at index. It must be published, see published(). */
+			inline T &operator[](const size_t index)
+			{
+				size_t offset;
+				const size_t b = locate(index, offset);
+				return this->buckets[b].load(std::memory_order_acquire)[offset];
+			}
+			inline const T &operator[](const size_t index) const{return const_cast<iConcurrentVector<T, FIRST> *>(this)->operator[](index);}
+
+			/* Returns true if the element at index is constructed and visible to this thread. */
+			inline bool published(const size_t index) const;
+
+			/* Returns the number of claimed indices, including ones under construction. */
+			inline size_t size(void) const{return this->claimed.load(std::memory_order_acquire);}
+
+			inline bool empty(void) const{return this->size() == 0;}
+
+			/* Returns the number of elements that fit without a new bucket. */
+			inline size_t capacity(void) const;
+
+			/* Returns the published elements in index order as one contiguous iVector. Call it
+			 * when the producers are done; elements published meanwhile may be missing. */
+			template<class GrowthPolicy = default_growth, class Allocator = GT::allocator<T> > inline iVector<T, GrowthPolicy, Allocator> flatten(void) const;
+
+			/* Destroys all elements, keeps the buckets. Not thread safe. */
+			inline void clear(void);
+
+			/* Frees the buckets behind the elements. Not thread safe. */
+			inline void shrink_to_fit(void);
+	};
+
+	template<class T, size_t FIRST> T *iConcurrentVector<T, FIRST>::bucket(const size_t b)
+	{
+		T *p = this->buckets[b].load(std::memory_order_acquire);
+		if(p != null_ptr) return p;
+
+		// calloc: the state bytes start at 0, the pages are touched by the threads that construct
+		const size_t n = bucket_size(b);
+		if(n > (size_t(-1) - n) / sizeof(T)) return null_ptr;
+		T *created = static_cast<T *>(std::calloc(sizeof(T) * n + n, 1));
+		if(created == null_ptr) return null_ptr;
+		if(this->buckets[b].compare_exchange_strong(p, created, std::memory_order_acq_rel, std::memory_order_acquire)) return created;
+		std::free(static_cast<void *>(created));	// another thread was faster
+		return p;
+	}
+
+	template<class T, size_t FIRST> template<class Make> size_t iConcurrentVector<T, FIRST>::claim(const size_t count, Make make)
+	{
+		if(count == 0) return this->size();
+		const size_t first = this->claimed.fetch_add(count, std::memory_order_acq_rel);
+		size_t offset;
+		for(size_t index = first, b = locate(first, offset); index < first + count; b++, offset = 0)
+		{
+			T *p = this->bucket(b);
+			if(p == null_ptr)
+			{
+                #ifdef GT_CERR_ACTIVE
+				std::cerr << "IN FUNCTION: template<class T, size_t FIRST> template<class Make> size_t iConcurrentVector<T, FIRST>::claim(const size_t count, Make make);" << std::endl;
+				std::cerr << "NOT ENOUGHT MEMORY." << std::endl;
+                #endif
+				return npos;
+			}
+			std::atomic<unsigned char> *state = states(p, b);
+			for(; offset < bucket_size(b) && index < first + count; offset++, index++)
+			{
+				make(p + offset, index);
+				state[offset].store(1, std::memory_order_release);
+			}
+		}
+		return first;
+	}
+
+	template<class T, size_t FIRST> bool iConcurrentVector<T, FIRST>::published(const size_t index) const
+	{
+		if(index >= this->size()) return false;
+		size_t offset;
+		const size_t b = locate(index, offset);
+		T *p = this->buckets[b].load(std::memory_order_acquire);
+		return p != null_ptr && states(p, b)[offset].load(std::memory_order_acquire) == 1;
+	}
+
+	template<class T, size_t FIRST> size_t iConcurrentVector<T, FIRST>::capacity(void) const
+	{
+		size_t total = 0;
+		for(size_t b=0; b<BUCKETS && this->buckets[b].load(std::memory_order_acquire) != null_ptr; b++) total += bucket_size(b);
+		return total;
+	}
+
+	template<class T, size_t FIRST> template<class GrowthPolicy, class Allocator>
+	iVector<T, GrowthPolicy, Allocator> iConcurrentVector<T, FIRST>::flatten(void) const
+	{
+		const size_t n = this->size();
+		iVector<T, GrowthPolicy, Allocator> out;
+		out.reserve(n);
+		for(size_t b=0, index=0; index < n; index += bucket_size(b), b++)
+		{
+			T *p = this->buckets[b].load(std::memory_order_acquire);
+			if(p == null_ptr) continue;
+			const std::atomic<unsigned char> *state = states(p, b);
+			const size_t count = n - index < bucket_size(b) ? n - index : bucket_size(b);
+			for(size_t i=0; i<count;)
+			{	// one insert per run of published elements
+				size_t j = i;
+				while(j < count && state[j].load(std::memory_order_acquire) == 1) j++;
+				out.insert(out.end(), p + i, p + j);
+				for(i = j; i < count && state[i].load(std::memory_order_acquire) != 1; i++){}
+			}
+		}
+		return out;
+	}
+
+	template<class T, size_t FIRST> void iConcurrentVector<T, FIRST>::clear(void)
+	{
+		const size_t n = this->size();
+		for(size_t b=0, index=0; index < n; index += bucket_size(b), b++)
+		{
+			T *p = this->buckets[b].load(std::memory_order_relaxed);
+			if(p == null_ptr) continue;
+			std::atomic<unsigned char> *state = states(p, b);
+			for(size_t i=0; i<bucket_size(b) && index + i < n; i++)
+				if(state[i].load(std::memory_order_relaxed) == 1)
+				{
+					p[i].~T();
+					state[i].store(0, std::memory_order_relaxed);
+				}
+		}
+		this->claimed.store(0, std::memory_order_release);
+	}
+
+	template<class T, size_t FIRST> void iConcurrentVector<T, FIRST>::shrink_to_fit(void)
+	{
+		const size_t n = this->size();
+		size_t b = 0;
+		for(size_t index=0; index < n; index += bucket_size(b), b++){}
+		for(; b<BUCKETS; b++)
+		{
+			std::free(static_cast<void *>(this->buckets[b].load(std::memory_order_relaxed)));
+			this->buckets[b].store(null_ptr, std::memory_order_relaxed);
+		}
+	}
+} // end of namespace GT
+#endif // ICONCURRENTVECTOR_H
@@ -0,0 +1,406 @@
+/*--------------------------------------------------------------------------------------------------*/
+/*      Autor: Georgios Terzoglou                                                                   */
+/*      Copyright (©) 2014 by Georgios Terzoglou                                                    */
+/*      Bug-reports and suggestions to georgios.terzoglou@googlemail.com                            */
+/*                                                                                                  */
+/*      GENERAL NOTE: I assume no liability for any damages with this header.                       */
+/*      Using this header at your own risk.                                                         */
+/*                                                                                                  */
+/*      Template class: iDequeVector<T, GrowthPolicy>                                               */
+/*                                                                                                  */
+/*      iDequeVectors are iVectors with reserved space in front of the first element as well as     */
+/*      behind the last one. push_front and pop_front run in amortized constant time, just like     */
+/*      push_back and pop_back, and the elements still lie in one contiguous array: operator T*(),  */
+/*      begin() and end() can be used like those of iVector. When one end runs out of space, the    */
+/*      elements are centered again in the array, or moved into a larger array that is chosen by    */
+/*      the GrowthPolicy (see ivector.h). Use it as a work queue where iVector::push_front and      */
+/*      iVector::pop_front would have to shift all elements.                                        */
+/*--------------------------------------------------------------------------------------------------*/
+
+#ifndef IDEQUEVECTOR_H
+#define IDEQUEVECTOR_H
+
+#include "ivector.h"
+
+namespace GT
+{
+	template<class T, class GrowthPolicy = default_growth> class iDequeVector
+	{
+		private:
+		// Attributes
+			husk_t core;	// important attributes, see class Husk
+			T *storage;		// begin of the dynamic array
+			T *objects;		// first element, storage + front headroom
+
+		// Private methods
+
+			/* Returns the number of free places in front of the first element */
+			inline size_t headroom(void) const{return this->objects - this->storage;}
+
+			/* Returns the number of free places behind the last element */
+			inline size_t tailroom(void) const{return this->core.actualCapacity - this->headroom() - this->core.actualSize;}
+
+			/* Makes at least one place free in front (atFront) or behind the elements. The elements are
+			 * centered in place if at most half of the array is used, otherwise moved into a grown array. */
+			inline void make_room(const bool atFront);
+
+			/* Leaves a moved-from object empty and without storage */
+			inline void release(void);
+
+			/* Returns raw storage for n elements. Throws std::bad_alloc if out of memory. */
+			static inline T *allocate_storage(const size_t n);
+
+		public:
+
+		// Iterator types
+			typedef T *iterator;
+			typedef const T *const_iterator;
+			typedef reverse_iterator_t<T> reverse_iterator;
+			typedef const reverse_iterator_t<T> const_reverse_iterator;
+
+
+		// Constructors
+
+			/* Creates an empty iDequeVector with room for initCapacity elements, half of it in front. */
+			inline explicit iDequeVector(const size_t initCapacity = 0): core(0, 0, 0, 0)
+			{	// 1. ascending   2. bearingsCount   3. actualSize   4. actualCapacity
+				this->core.actualCapacity = GrowthPolicy::initial(this->core, initCapacity);
+				this->storage = allocate_storage(this->core.actualCapacity);
+				this->objects = this->storage + this->core.actualCapacity / 2;
+			}
+
+			/* The copy ctor Creates a copy of src. */
+			inline iDequeVector(const iDequeVector<T, GrowthPolicy> &src): core(src.core)
+			{
+				this->storage = allocate_storage(src.capacity());
+				this->objects = this->storage + src.headroom();
+				try
+				{
+					detail::uninitialized_copy_range(src.begin(), src.end(), this->objects);
+				}
+				catch(...)
+				{
+					detail::deallocate_raw(this->storage);
+					throw;
+				}
+			}
+
+			/* The move ctor takes over the storage of src. src is left empty without storage. */
+			inline iDequeVector(iDequeVector<T, GrowthPolicy> &&src) noexcept: core(src.core), storage(src.storage), objects(src.objects)
+			{
+				src.release();
+			}
+
+			/* Creates a copy of the elements of an iVector. */
+			template<class P, class A> inline explicit iDequeVector(const iVector<T, P, A> &src): core(0, 0, 0, 0)
+			{
+				this->core.actualCapacity = GrowthPolicy::initial(this->core, src.size() * 2);
+				this->storage = allocate_storage(this->core.actualCapacity);
+				this->objects = this->storage + (this->core.actualCapacity - src.size()) / 2;
+				try
+				{
+					detail::uninitialized_copy_range(src.begin(), src.end(), this->objects);
+				}
+				catch(...)
+				{
+					detail::deallocate_raw(this->storage);
+					throw;
+				}
+				this->core.actualSize = src.size();
+			}
+
+
+		// Destructor
+			~iDequeVector();
+
+
+		// Methods
+
+			/* Inserts a copy of x to the begin of self. Amortized constant time. */
+			inline void push_front(const T &x){this->emplace_front(x);}
+
+			/* Moves x to the begin of self. Amortized constant time. */
+			inline void push_front(T &&x){this->emplace_front(std::move(x));}
+
+			/* Constructs an element in place at the begin of self. Returns a reference to it. */
+			template<class... Args> inline T &emplace_front(Args&&... args);
+
+			/* Removes the first element of self. Constant time, the place becomes front headroom. */
+			inline void pop_front(void);
+
+			/* Inserts a copy of x to the end of self. Amortized constant time. */
+			inline void push_back(const T &x){this->emplace_back(x);}
+
+			/* Moves x to the end of self. Amortized constant time. */
+			inline void push_back(T &&x){this->emplace_back(std::move(x));}
+
+			/* Constructs an element in place at the end of self. Returns a reference to it. */
+			template<class... Args> inline T &emplace_back(Args&&... args);
+
+			/* Removes the last element of self. Constant time. */
+			inline void pop_back(void);
+
+			/* Inserts x before position, the shorter side of the elements is shifted.
+			 * Returns an iterator that points to the new element. */
+			template<class... Args> inline iterator emplace(const_iterator position, Args&&... args);
+			inline iterator insert(const_iterator position, const T &x){return this->emplace(position, x);}
+			inline iterator insert(const_iterator position, T &&x){return this->emplace(position, std::move(x));}
+
+			/* Deletes the elements in [first, last), the shorter side of the elements is shifted.
+			 * Returns an iterator that points to the element behind the erased ones. */
+			inline iterator erase(const_iterator first, const_iterator last);
+			inline iterator erase(const_iterator position){return this->erase(position, position + 1);}
+
+			/* Increases the capacity to at least newCapacity. The front headroom is kept. */
+			inline void reserve(const size_t newCapacity);
+
+			/* Alters the size of self, see iVector::resize. */
+			inline void resize(const size_t newSize);
+
+			/* Deletes all elements, the capacity is kept and the elements begin in the middle again. */
+			inline void clear(void);
+
+			/* Exchanges self with src. */
+			inline void swap(iDequeVector<T, GrowthPolicy> &src);
+
+			/* Sorts the elements into ascending order. */
+			inline void sort(void){std::sort(this->begin(), this->end());}
+
+			/* Changes the Direction of all elements. */
+			inline void mirror(void){detail::reverse_range(this->begin(), this->end());}
+
+			/* Returns true if the size is zero. */
+			inline bool empty(void) const{return this->core.actualSize == 0;}
+
+			/* Returns the number of elements. */
+			inline size_t size(void) const{return this->core.actualSize;}
+
+			/* Returns the size of the allocated storage, headroom at both ends included. */
+			inline size_t capacity(void) const{return this->core.actualCapacity;}
+
+			/* Return actual core */
+			inline husk_t getCore(void) const{return this->core;}
+
+			/* Returns a reference to the first element. */
+			inline T &front(void){return this->objects[0];}
+			inline const T &front(void) const{return this->objects[0];}
+
+			/* Returns a reference to the last element. */
+			inline T &back(void){return this->objects[this->core.actualSize - 1];}
+			inline const T &back(void) const{return this->objects[this->core.actualSize - 1];}
+
+			/* Returns a reference to element n of self. If n is out of range the last element is returned. */
+			inline T &at(const size_t index){return this->objects[index < this->core.actualSize ? index : this->core.actualSize - 1];}
+			inline const T &at(const size_t index) const{return this->objects[index < this->core.actualSize ? index : this->core.actualSize - 1];}
+
+
+		// Operators
+
+			/* cast the iDequeVector obj in the basic T* datatype, the elements are contiguous */
+			inline operator T*() const{return this->objects;}
+
+			/* The assignment operator replaces the elements of self with a copy of the elements of rhs. */
+			inline iDequeVector<T, GrowthPolicy> &operator=(const iDequeVector<T, GrowthPolicy> &rhs)
+			{
+				if(this != &rhs)
+				{
+					iDequeVector<T, GrowthPolicy> temp(rhs);
+					this->swap(temp);
+				}
+				return *this;
+			}
+
+			/* The move assignment takes over the storage of rhs. */
+			inline iDequeVector<T, GrowthPolicy> &operator=(iDequeVector<T, GrowthPolicy> &&rhs) noexcept
+			{
+				this->swap(rhs);
+				return *this;
+			}
+
+			/* Returns a reference to element n of self. The index n must be between 0 and the size less one. */
+			inline T &operator[](const size_t index){return this->objects[index];}
+			inline const T &operator[](const size_t index) const{return this->objects[index];}
+
+
+		// Iterators
+			inline iterator begin(void){return this->objects;}
+			inline const_iterator begin(void) const{return this->objects;}
+			inline iterator end(void){return this->objects + this->core.actualSize;}
+			inline const_iterator end(void) const{return this->objects + this->core.actualSize;}
+			inline reverse_iterator rbegin(void){return reverse_iterator(this->objects + this->core.actualSize - 1);}
+			inline const_reverse_iterator rbegin(void) const{return const_reverse_iterator(this->objects + this->core.actualSize - 1);}
+			inline reverse_iterator rend(void){return reverse_iterator(this->objects - 1);}
+			inline const_reverse_iterator rend(void) const{return const_reverse_iterator(this->objects - 1);}
+	};
+
+	template<class T, class GrowthPolicy> iDequeVector<T, GrowthPolicy>::~iDequeVector()
+	{
+		detail::destroy_range(this->begin(), this->end());
+		detail::deallocate_raw(this->storage);
+	}
+
+	template<class T, class GrowthPolicy> void iDequeVector<T, GrowthPolicy>::release(void)
+	{	// 1. ascending   2. bearingsCount   3. actualSize   4. actualCapacity
+		this->core.setHusk(0, 0, 0, 0);
+		this->storage = this->objects = null_ptr;
+	}
+
+	template<class T, class GrowthPolicy> T *iDequeVector<T, GrowthPolicy>::allocate_storage(const size_t n)
+	{
+		T *p = detail::allocate_raw<T>(n);
+		if(p == null_ptr)
+		{
+            #ifdef GT_CERR_ACTIVE
+			std::cerr << "IN FUNCTION: template<class T, class GrowthPolicy> T *iDequeVector<T, GrowthPolicy>::allocate_storage(const size_t n);" << std::endl;
+			std::cerr << "NOT ENOUGHT MEMORY." << std::endl;
+            #endif
+			throw std::bad_alloc();
+		}
+		return p;
+	}
+
+	template<class T, class GrowthPolicy> void iDequeVector<T, GrowthPolicy>::make_room(const bool atFront)
+	{
+		const size_t size = this->core.actualSize;
+		if(size * 2 < this->core.actualCapacity)
+		{	// at least half is free: center the elements, O(size) after at least size / 2 cheap calls
+			const size_t free = this->core.actualCapacity - size;
+			const size_t head = (atFront && free / 2 == 0) ? free : free / 2;
+			detail::relocate_overlapping(this->begin(), this->end(), this->storage + head);
+			this->objects = this->storage + head;
+			return;
+		}
+
+		const size_t newCapacity = this->core.actualCapacity == 0 ?
+				GrowthPolicy::initial(this->core, size + 1) : GrowthPolicy::grow(this->core, size + 1);
+		T *newStorage = allocate_storage(newCapacity);
+		const size_t free = newCapacity - size;
+		const size_t head = (atFront && free / 2 == 0) ? free : free / 2;
+		detail::relocate_range(this->begin(), this->end(), newStorage + head);
+		detail::deallocate_raw(this->storage);
+		this->storage = newStorage;
+		this->objects = newStorage + head;
+		this->core.actualCapacity = newCapacity;
+	}
+
+	template<class T, class GrowthPolicy> template<class... Args> T &iDequeVector<T, GrowthPolicy>::emplace_front(Args&&... args)
+	{
+		if(this->headroom() == 0)
+		{
+			T item(std::forward<Args>(args)...); // args may refer into self
+			this->make_room(true);
+			::new(static_cast<void *>(this->objects - 1)) T(std::move(item));
+		}
+		else ::new(static_cast<void *>(this->objects - 1)) T(std::forward<Args>(args)...);
+		--this->objects;
+		++this->core.actualSize;
+		return this->objects[0];
+	}
+
+	template<class T, class GrowthPolicy> template<class... Args> T &iDequeVector<T, GrowthPolicy>::emplace_back(Args&&... args)
+	{
+		if(this->tailroom() == 0)
+		{
+			T item(std::forward<Args>(args)...); // args may refer into self
+			this->make_room(false);
+			::new(static_cast<void *>(this->end())) T(std::move(item));
+		}
+		else ::new(static_cast<void *>(this->end())) T(std::forward<Args>(args)...);
+		return this->objects[this->core.actualSize++];
+	}
+
+	template<class T, class GrowthPolicy> void iDequeVector<T, GrowthPolicy>::pop_front(void)
+	{
+		this->objects->~T();
+		++this->objects;
+		--this->core.actualSize;
+	}
+
+	template<class T, class GrowthPolicy> void iDequeVector<T, GrowthPolicy>::pop_back(void)
+	{
+		(this->objects + --this->core.actualSize)->~T();
+	}
+
+	template<class T, class GrowthPolicy> template<class... Args> typename iDequeVector<T, GrowthPolicy>::iterator
+		iDequeVector<T, GrowthPolicy>::emplace(const_iterator position, Args&&... args)
+	{
+		const size_t index = position - this->begin();
+		if(index == 0) return &this->emplace_front(std::forward<Args>(args)...);
+		if(index >= this->size()) return &this->emplace_back(std::forward<Args>(args)...);
+
+		T item(std::forward<Args>(args)...); // args may refer into self
+		if(index < this->size() / 2)
+		{	// shift the front part down
+			if(this->headroom() == 0) this->make_room(true);
+			detail::relocate_overlapping(this->objects, this->objects + index, this->objects - 1);
+			--this->objects;
+		}
+		else
+		{	// shift the back part up
+			if(this->tailroom() == 0) this->make_room(false);
+			detail::relocate_overlapping(this->objects + index, this->end(), this->objects + index + 1);
+		}
+		::new(static_cast<void *>(this->objects + index)) T(std::move(item));
+		++this->core.actualSize;
+		return this->objects + index;
+	}
+
+	template<class T, class GrowthPolicy> typename iDequeVector<T, GrowthPolicy>::iterator
+		iDequeVector<T, GrowthPolicy>::erase(const_iterator first, const_iterator last)
+	{
+		const size_t index = first - this->begin(), pieces = last - first;
+		if(pieces == 0) return this->begin() + index;
+
+		detail::destroy_range(this->objects + index, this->objects + index + pieces);
+		if(index < this->size() - index - pieces)
+		{	// shift the front part up
+			detail::relocate_overlapping(this->objects, this->objects + index, this->objects + pieces);
+			this->objects += pieces;
+		}
+		else detail::relocate_overlapping(this->objects + index + pieces, this->end(), this->objects + index);
+		this->core.actualSize -= pieces;
+		return this->begin() + index;
+	}
+
+	template<class T, class GrowthPolicy> void iDequeVector<T, GrowthPolicy>::reserve(const size_t newCapacity)
+	{
+		if(newCapacity <= this->core.actualCapacity) return;
+		T *newStorage = allocate_storage(newCapacity);
+		const size_t head = this->headroom();
+		detail::relocate_range(this->begin(), this->end(), newStorage + head);
+		detail::deallocate_raw(this->storage);
+		this->storage = newStorage;
+		this->objects = newStorage + head;
+		this->core.actualCapacity = newCapacity;
+	}
+
+	template<class T, class GrowthPolicy> void iDequeVector<T, GrowthPolicy>::resize(const size_t newSize)
+	{
+		if(newSize > this->size())
+		{
+			if(newSize - this->size() > this->tailroom())
+			{
+				if(newSize > size_t(-1) - this->headroom()) throw std::bad_alloc();
+				this->reserve(this->headroom() + GrowthPolicy::grow(this->core, newSize));
+			}
+			std::uninitialized_fill(this->end(), this->begin() + newSize, T());
+		}
+		else detail::destroy_range(this->begin() + newSize, this->end());
+		this->core.actualSize = newSize;
+	}
+
+	template<class T, class GrowthPolicy> void iDequeVector<T, GrowthPolicy>::clear(void)
+	{
+		detail::destroy_range(this->begin(), this->end());
+		this->core.actualSize = 0;
+		this->objects = this->storage + this->core.actualCapacity / 2;
+	}
+
+	template<class T, class GrowthPolicy> void iDequeVector<T, GrowthPolicy>::swap(iDequeVector<T, GrowthPolicy> &src)
+	{
+		std::swap(this->core, src.core);
+		std::swap(this->storage, src.storage);
+		std::swap(this->objects, src.objects);
+	}
+} // end of namespace GT
+#endif // IDEQUEVECTOR_H
@@ -0,0 +1,522 @@
+/*--------------------------------------------------------------------------------------------------*/
+/*      Autor: Georgios Terzoglou                                                                   */
+/*      Copyright (©) 2014 by Georgios Terzoglou                                                    */
+/*      Bug-reports and suggestions to georgios.terzoglou@googlemail.com                            */
+/*                                                                                                  */
+/*      GENERAL NOTE: I assume no liability for any damages with this header.                       */
+/*      Using this header at your own risk.                                                         */
+/*                                                                                                  */
+/*      Template classes: iFlatSet<Key, Compare, GrowthPolicy>, iFlatMap<Key, T, Compare, ...>      */
+/*                                                                                                  */
+/*      Sorted associative containers on iVectors. The keys are one sorted, duplicate free          */
+/*      array, lookups are binary searches without branches on the comparison. iFlatMap keeps       */
+/*      the keys and the mapped values in two arrays, so a lookup only reads keys. A bulk           */
+/*      insert(first, last) sorts the batch, drops duplicates and merges it in one linear pass.     */
+/*      For large, mostly read tables build_index() adds a copy of the keys in Eytzinger (BFS)      */
+/*      order whose searches prefetch the next levels; every change drops the index again.          */
+/*--------------------------------------------------------------------------------------------------*/
+
+#ifndef IFLATMAP_H
+#define IFLATMAP_H
+
+#include "ivector.h"
+
+#include <utility>
+
+namespace GT
+{
+	namespace detail
+	{
+		/* Returns the index of the first of the n sorted keys at first that is not less than x.
+		 * The loop runs a fixed log2(n) steps and selects with a conditional move. */
+		template<class K, class Compare> inline size_t branchless_lower_bound(const K *first, size_t n, const K &x, const Compare &comp)
+		{
+			if(n == 0) return 0;
+			const K *base = first;
+			while(n > 1)
+			{
+				const size_t half = n / 2;
+            #if defined(__GNUC__) || defined(__clang__)
+				__builtin_prefetch(base + half / 2);
+				__builtin_prefetch(base + half + half / 2);
+            #endif
+				base = comp(base[half], x) ? base + half : base;
+				n -= half;
+			}
+			return size_t(base - first) + (comp(*base, x) ? 1 : 0);
+		}
+
+		/* A copy of sorted keys in Eytzinger order: the implicit binary tree whose node k has the
+		 * children 2k and 2k + 1, stored level by level. The top levels share few cache lines and
+		 * the descent prefetches the nodes 4 levels ahead. The index of the key of a node follows
+		 * from k and n, see rank(). */
+		template<class K> class eytzinger_index
+		{
+			private:
+				iVector<K> tree;		// node k at tree[k - 1]
+
+				static inline size_t floor_log2(const size_t x)
+				{
+            #if defined(__GNUC__) || defined(__clang__)
+					return 8 * sizeof(unsigned long long) - 1 - size_t(__builtin_clzll(x));
+            #else
+					size_t l = 0;
+					while((x >> l) > 1) l++;
+					return l;
+            #endif
+				}
+
+				/* Returns the in-order position of node k of n: its position p in the perfect tree down
+				 * to the last level, minus the missing nodes of the last level in front of it. Those sit
+				 * at the even positions, the first m = n - (2^last - 1) of them exist. */
+				static inline size_t rank(const size_t k, const size_t n)
+				{
+					const size_t last = floor_log2(n), depth = floor_log2(k);
+					const size_t p = ((2 * (k - (size_t(1) << depth)) + 1) << (last - depth)) - 1;
+					const size_t m = n - ((size_t(1) << last) - 1), before = (p + 1) / 2;
+					return before > m ? p - (before - m) : p;
+				}
+
+			public:
+				/* Returns true if no index is built */
+				inline bool empty(void) const{return this->tree.empty();}
+
+				/* Builds the index of the n sorted keys at sorted */
+				inline void build(const K *sorted, const size_t n)
+				{
+					this->clear();
+					this->tree.reserve(n);
+					for(size_t k=1; k<=n; k++) this->tree.push_back(sorted[rank(k, n)]);
+				}
+
+				/* Drops the index and its memory */
+				inline void clear(void)
+				{
+					this->tree.clear();
+					this->tree.shrink_to_fit();
+				}
+
+				/* Returns the index of the first key that is not less than x like branchless_lower_bound */
+				template<class Compare> inline size_t lower_bound(const K &x, const Compare &comp) const
+				{
+					const size_t n = this->tree.size();
+					size_t k = 1;
+					while(k <= n)
+					{
+                    #if defined(__GNUC__) || defined(__clang__)
+						if(16 * k <= n) __builtin_prefetch(&this->tree[16 * k - 1]);
+                    #endif
+						k = 2 * k + (comp(this->tree[k - 1], x) ? 1 : 0);
+					}
+					// the last left turn of the descent is the answer: drop the right turns and it
+                #if defined(__GNUC__) || defined(__clang__)
+					k >>= __builtin_ctzll(~static_cast<unsigned long long>(k)) + 1;
+                #else
+					while(k & 1) k >>= 1;
+					k >>= 1;
+                #endif
+					return k == 0 ? n : rank(k, n);
+				}
+		};
+	} // end of namespace detail
+
+	template<class Key, class Compare = std::less<Key>, class GrowthPolicy = default_growth> class iFlatSet
+	{
+		public:
+		// Container types
+			typedef Key key_type;
+			typedef Key value_type;
+			typedef Compare key_compare;
+
+		// Iterator types, the keys are constant
+			typedef const Key *iterator;
+			typedef const Key *const_iterator;
+
+		private:
+		// Attributes
+			iVector<Key, GrowthPolicy> items;	// sorted, no duplicates
+			Compare comp;
+			detail::eytzinger_index<Key> index;
+
+			inline bool equal(const Key &a, const Key &b) const{return !this->comp(a, b) && !this->comp(b, a);}
+
+		public:
+
+		// Constructors
+
+			/* Creates an empty iFlatSet. No memory is allocated. */
+			inline explicit iFlatSet(const Compare &comp = Compare()): comp(comp){}
+
+			/* Creates an iFlatSet of the elements in [first, last) */
+			template<class InputIterator> inline iFlatSet(InputIterator first, InputIterator last, const Compare &comp = Compare()): comp(comp)
+			{
+				this->insert(first, last);
+			}
+
+			/* Adopts the elements of a (possibly unsorted) iVector, sorts it and drops duplicates */
+			inline explicit iFlatSet(iVector<Key, GrowthPolicy> &&src, const Compare &comp = Compare()): items(std::move(src)), comp(comp)
+			{
+				std::sort(this->items.begin(), this->items.end(), this->comp);
+				this->items.erase(std::unique(this->items.begin(), this->items.end(), [this](const Key &a, const Key &b){return this->equal(a, b);}), this->items.end());
+			}
+
+		// Methods
+			/* Returns the first element not less than x, end() if there is none. */
+			inline const_iterator lower_bound(const Key &x) const
+			{
+				return this->begin() + (this->index.empty() ? detail::branchless_lower_bound(this->items.begin(), this->items.size(), x, this->comp)
+															: this->index.lower_bound(x, this->comp));
+			}
+
+			/* Returns the first element greater than x, end() if there is none. */
+			inline const_iterator upper_bound(const Key &x) const
+			{
+				const_iterator it = this->lower_bound(x);
+				return it != this->end() && !this->comp(x, *it) ? it + 1 : it;
+			}
+
+			/* Returns the element equal to x, end() if there is none. */
+			inline const_iterator find(const Key &x) const
+			{
+				const_iterator it = this->lower_bound(x);
+				return it != this->end() && !this->comp(x, *it) ? it : this->end();
+			}
+
+			inline bool contains(const Key &x) const{return this->find(x) != this->end();}
+			inline size_t count(const Key &x) const{return this->contains(x) ? 1 : 0;}
+
+			/* Inserts x at its sorted position unless an equal element exists. Returns the
+			 * element and true if it was inserted. Linear time, see insert(first, last). */
+			inline std::pair<iterator, bool> insert_sorted(const Key &x);
+
+			/* Inserts the elements of [first, last): sorts the batch, drops duplicates and
+			 * elements already present, then merges it with the content in one linear pass. */
+			template<class InputIterator> inline void insert(InputIterator first, InputIterator last);
+
+			/* Removes the element equal to x, returns the number of removed elements. */
+			inline size_t erase(const Key &x)
+			{
+				const_iterator it = this->find(x);
+				if(it == this->end()) return 0;
+				this->erase(it);
+				return 1;
+			}
+
+			/* Removes the element at position, returns the element behind it. */
+			inline iterator erase(const_iterator position)
+			{
+				this->index.clear();
+				return this->items.erase(position, position + 1);
+			}
+
+			/* Builds the Eytzinger copy of the keys for faster searches in large tables. It takes
+			 * n more keys of memory and is dropped by the next change of the set. */
+			inline void build_index(void){this->index.build(this->items.begin(), this->items.size());}
+
+			/* Returns the sorted elements as an iVector */
+			inline const iVector<Key, GrowthPolicy> &sequence(void) const{return this->items;}
+
+			inline size_t size(void) const{return this->items.size();}
+			inline bool empty(void) const{return this->items.empty();}
+			inline size_t capacity(void) const{return this->items.capacity();}
+			inline void reserve(const size_t newCapacity){this->items.reserve(newCapacity);}
+			inline void clear(void){this->index.clear(); this->items.clear();}
+			inline void shrink_to_fit(void){this->items.shrink_to_fit();}
+			inline void swap(iFlatSet<Key, Compare, GrowthPolicy> &src)
+			{
+				this->items.swap(src.items);
+				std::swap(this->comp, src.comp);
+				std::swap(this->index, src.index);
+			}
+
+		// Iterators
+			inline const_iterator begin(void) const{return this->items.begin();}
+			inline const_iterator end(void) const{return this->items.end();}
+	};
+
+	template<class Key, class Compare, class GrowthPolicy>
+	std::pair<typename iFlatSet<Key, Compare, GrowthPolicy>::iterator, bool> iFlatSet<Key, Compare, GrowthPolicy>::insert_sorted(const Key &x)
+	{
+		const_iterator it = this->lower_bound(x);
+		if(it != this->end() && !this->comp(x, *it)) return std::make_pair(it, false);
+		this->index.clear();
+		return std::make_pair(iterator(this->items.insert(it, x)), true);
+	}
+
+	template<class Key, class Compare, class GrowthPolicy> template<class InputIterator>
+	void iFlatSet<Key, Compare, GrowthPolicy>::insert(InputIterator first, InputIterator last)
+	{
+		iVector<Key, GrowthPolicy> batch;
+		for(; first != last; ++first) batch.push_back(*first);
+		std::stable_sort(batch.begin(), batch.end(), this->comp);
+		batch.erase(std::unique(batch.begin(), batch.end(), [this](const Key &a, const Key &b){return this->equal(a, b);}), batch.end());
+		if(batch.empty()) return;
+		this->index.clear();
+		if(this->items.empty())
+		{
+			this->items.swap(batch);
+			return;
+		}
+
+		// the content is only moved if that cannot throw, so it survives a failed merge
+		iVector<Key, GrowthPolicy> merged;
+		merged.reserve(this->items.size() + batch.size());
+		Key *a = this->items.begin(), *b = batch.begin();
+		while(a != this->items.end() && b != batch.end())
+		{
+			if(this->comp(*b, *a)) merged.push_back(std::move(*b++));
+			else
+			{
+				if(!this->comp(*a, *b)) ++b;	// already present
+				merged.push_back(std::move_if_noexcept(*a++));
+			}
+		}
+		for(; a != this->items.end(); ++a) merged.push_back(std::move_if_noexcept(*a));
+		for(; b != batch.end(); ++b) merged.push_back(std::move(*b));
+		this->items.swap(merged);
+	}
+
+	namespace detail
+	{
+		/* Iterator of an iFlatMap: the map and an index. Dereferencing returns the pair of
+		 * references (key, value), operator-> a pointer-like holder of that pair. */
+		template<class Map, class K, class V> class flat_map_iterator
+		{
+			template<class, class, class> friend class flat_map_iterator;
+
+			private:
+				Map *owner;
+				size_t index;
+
+			public:
+				typedef std::pair<const K &, V &> reference;
+				struct pointer
+				{
+					reference pair;
+					inline reference *operator->(void){return &this->pair;}
+				};
+
+				typedef std::random_access_iterator_tag iterator_category;
+				typedef std::pair<K, typename std::remove_const<V>::type> value_type;
+				typedef std::ptrdiff_t difference_type;
+
+				inline flat_map_iterator(void): owner(null_ptr), index(0){}
+				inline flat_map_iterator(Map *owner, const size_t index): owner(owner), index(index){}
+
+				/* iterator to const_iterator */
+				template<class M, class Y, class = typename std::enable_if<std::is_convertible<M *, Map *>::value>::type>
+				inline flat_map_iterator(const flat_map_iterator<M, K, Y> &src): owner(src.owner), index(src.index){}
+
+				/* Returns the index of the entry in the map */
+				inline size_t position(void) const{return this->index;}
+
+				inline reference operator*(void) const{return reference(this->owner->keys()[this->index], this->owner->values()[this->index]);}
+				inline pointer operator->(void) const{pointer p = {**this}; return p;}
+				inline reference operator[](const difference_type n) const{return *(*this + n);}
+
+				inline flat_map_iterator &operator++(void){++this->index; return *this;}
+				inline flat_map_iterator &operator--(void){--this->index; return *this;}
+				inline flat_map_iterator operator++(int){flat_map_iterator old(*this); ++this->index; return old;}
+				inline flat_map_iterator operator--(int){flat_map_iterator old(*this); --this->index; return old;}
+				inline flat_map_iterator &operator+=(const difference_type n){this->index += n; return *this;}
+				inline flat_map_iterator &operator-=(const difference_type n){this->index -= n; return *this;}
+				inline flat_map_iterator operator+(const difference_type n) const{return flat_map_iterator(this->owner, this->index + n);}
+				inline flat_map_iterator operator-(const difference_type n) const{return flat_map_iterator(this->owner, this->index - n);}
+				friend inline flat_map_iterator operator+(const difference_type n, const flat_map_iterator &it){return it + n;}
+
+				template<class M, class Y> inline difference_type operator-(const flat_map_iterator<M, K, Y> &it) const{return difference_type(this->index - it.index);}
+				template<class M, class Y> inline bool operator==(const flat_map_iterator<M, K, Y> &it) const{return this->index == it.index;}
+				template<class M, class Y> inline bool operator!=(const flat_map_iterator<M, K, Y> &it) const{return this->index != it.index;}
+				template<class M, class Y> inline bool operator<(const flat_map_iterator<M, K, Y> &it) const{return this->index < it.index;}
+				template<class M, class Y> inline bool operator>(const flat_map_iterator<M, K, Y> &it) const{return this->index > it.index;}
+				template<class M, class Y> inline bool operator<=(const flat_map_iterator<M, K, Y> &it) const{return this->index <= it.index;}
+				template<class M, class Y> inline bool operator>=(const flat_map_iterator<M, K, Y> &it) const{return this->index >= it.index;}
+		};
+	} // end of namespace detail
+
+	template<class Key, class T, class Compare = std::less<Key>, class GrowthPolicy = default_growth> class iFlatMap
+	{
+		public:
+		// Container types
+			typedef Key key_type;
+			typedef T mapped_type;
+			typedef std::pair<Key, T> value_type;
+			typedef Compare key_compare;
+
+		// Iterator types
+			typedef detail::flat_map_iterator<iFlatMap<Key, T, Compare, GrowthPolicy>, Key, T> iterator;
+			typedef detail::flat_map_iterator<const iFlatMap<Key, T, Compare, GrowthPolicy>, Key, const T> const_iterator;
+
+		private:
+		// Attributes
+			iVector<Key, GrowthPolicy> keyArray;	// sorted, no duplicates
+			iVector<T, GrowthPolicy> valueArray;	// valueArray[i] belongs to keyArray[i]
+			Compare comp;
+			detail::eytzinger_index<Key> index;
+
+			inline size_t lower_index(const Key &x) const
+			{
+				return this->index.empty() ? detail::branchless_lower_bound(this->keyArray.begin(), this->keyArray.size(), x, this->comp)
+										   : this->index.lower_bound(x, this->comp);
+			}
+
+			inline size_t find_index(const Key &x) const
+			{
+				const size_t i = this->lower_index(x);
+				return i != this->keyArray.size() && !this->comp(x, this->keyArray[i]) ? i : this->keyArray.size();
+			}
+
+		public:
+
+		// Constructors
+
+			/* Creates an empty iFlatMap. No memory is allocated. */
+			inline explicit iFlatMap(const Compare &comp = Compare()): comp(comp){}
+
+			/* Creates an iFlatMap of the (key, value) pairs in [first, last), see insert(first, last) */
+			template<class InputIterator> inline iFlatMap(InputIterator first, InputIterator last, const Compare &comp = Compare()): comp(comp)
+			{
+				this->insert(first, last);
+			}
+
+		// Operators
+			/* Returns the value of key, inserts a value-initialized one if key is missing. */
+			inline T &operator[](const Key &key)
+			{
+				const size_t i = this->find_index(key);
+				return i != this->keyArray.size() ? this->valueArray[i] : (*this->insert_sorted(key, T()).first).second;
+			}
+
+		// Methods
+			/* Returns the first entry whose key is not less than x, end() if there is none. */
+			inline iterator lower_bound(const Key &x){return iterator(this, this->lower_index(x));}
+			inline const_iterator lower_bound(const Key &x) const{return const_iterator(this, this->lower_index(x));}
+
+			/* Returns the entry of key x, end() if there is none. */
+			inline iterator find(const Key &x){return iterator(this, this->find_index(x));}
+			inline const_iterator find(const Key &x) const{return const_iterator(this, this->find_index(x));}
+
+			inline bool contains(const Key &x) const{return this->find_index(x) != this->keyArray.size();}
+			inline size_t count(const Key &x) const{return this->contains(x) ? 1 : 0;}
+
+			/* Inserts (key, value) at its sorted position unless key exists. Returns the entry and
+			 * true if it was inserted. Linear time, see insert(first, last). */
+			inline std::pair<iterator, bool> insert_sorted(const Key &key, const T &value);
+
+			/* Inserts the (key, value) pairs of [first, last): sorts the batch by key, keeps the first
+			 * pair of equal keys and skips keys already present, then merges in one linear pass. */
+			template<class InputIterator> inline void insert(InputIterator first, InputIterator last);
+
+			/* Removes the entry of key x, returns the number of removed entries. */
+			inline size_t erase(const Key &x)
+			{
+				const size_t i = this->find_index(x);
+				if(i == this->keyArray.size()) return 0;
+				this->index.clear();
+				this->keyArray.erase(this->keyArray.begin() + i, this->keyArray.begin() + i + 1);
+				this->valueArray.erase(this->valueArray.begin() + i, this->valueArray.begin() + i + 1);
+				return 1;
+			}
+
+			/* Builds the Eytzinger copy of the keys for faster searches in large maps. It takes
+			 * n more keys of memory and is dropped by the next insert or erase. */
+			inline void build_index(void){this->index.build(this->keyArray.begin(), this->keyArray.size());}
+
+			/* Returns the sorted keys and the values in the same order. The values may be changed. */
+			inline const iVector<Key, GrowthPolicy> &keys(void) const{return this->keyArray;}
+			inline iVector<T, GrowthPolicy> &values(void){return this->valueArray;}
+			inline const iVector<T, GrowthPolicy> &values(void) const{return this->valueArray;}
+
+			inline size_t size(void) const{return this->keyArray.size();}
+			inline bool empty(void) const{return this->keyArray.empty();}
+			inline size_t capacity(void) const{return this->keyArray.capacity();}
+
+			/* Reserves both arrays, inserts up to newCapacity entries reallocate neither. */
+			inline void reserve(const size_t newCapacity){this->keyArray.reserve(newCapacity); this->valueArray.reserve(newCapacity);}
+
+			inline void clear(void){this->index.clear(); this->keyArray.clear(); this->valueArray.clear();}
+			inline void shrink_to_fit(void){this->keyArray.shrink_to_fit(); this->valueArray.shrink_to_fit();}
+			inline void swap(iFlatMap<Key, T, Compare, GrowthPolicy> &src)
+			{
+				this->keyArray.swap(src.keyArray);
+				this->valueArray.swap(src.valueArray);
+				std::swap(this->comp, src.comp);
+				std::swap(this->index, src.index);
+			}
+
+		// Iterators
+			inline iterator begin(void){return iterator(this, 0);}
+			inline const_iterator begin(void) const{return const_iterator(this, 0);}
+			inline iterator end(void){return iterator(this, this->keyArray.size());}
+			inline const_iterator end(void) const{return const_iterator(this, this->keyArray.size());}
+	};
+
+	template<class Key, class T, class Compare, class GrowthPolicy>
+	std::pair<typename iFlatMap<Key, T, Compare, GrowthPolicy>::iterator, bool> iFlatMap<Key, T, Compare, GrowthPolicy>::insert_sorted(const Key &key, const T &value)
+	{
+		const size_t i = this->lower_index(key);
+		if(i != this->keyArray.size() && !this->comp(key, this->keyArray[i])) return std::make_pair(iterator(this, i), false);
+		this->index.clear();
+		this->valueArray.insert(this->valueArray.begin() + i, value);
+		try
+		{
+			this->keyArray.insert(this->keyArray.begin() + i, key);
+		}
+		catch(...)
+		{	// keep both arrays of the same length
+			this->valueArray.erase(this->valueArray.begin() + i, this->valueArray.begin() + i + 1);
+			throw;
+		}
+		return std::make_pair(iterator(this, i), true);
+	}
+
+	template<class Key, class T, class Compare, class GrowthPolicy> template<class InputIterator>
+	void iFlatMap<Key, T, Compare, GrowthPolicy>::insert(InputIterator first, InputIterator last)
+	{
+		iVector<value_type> batch;
+		for(; first != last; ++first) batch.push_back(value_type(first->first, first->second));
+		Compare &less = this->comp;
+		std::stable_sort(batch.begin(), batch.end(), [&](const value_type &a, const value_type &b){return less(a.first, b.first);});
+		batch.erase(std::unique(batch.begin(), batch.end(), [&](const value_type &a, const value_type &b){return !less(a.first, b.first) && !less(b.first, a.first);}),
+					batch.end());
+		if(batch.empty()) return;
+		this->index.clear();
+
+		// the content is only moved if that cannot throw, so it survives a failed merge
+		iVector<Key, GrowthPolicy> keys;
+		iVector<T, GrowthPolicy> values;
+		keys.reserve(this->keyArray.size() + batch.size());
+		values.reserve(this->keyArray.size() + batch.size());
+		size_t a = 0;
+		value_type *b = batch.begin();
+		while(a != this->keyArray.size() && b != batch.end())
+		{
+			if(less(b->first, this->keyArray[a]))
+			{
+				keys.push_back(std::move(b->first));
+				values.push_back(std::move(b->second));
+				++b;
+			}
+			else
+			{
+				if(!less(this->keyArray[a], b->first)) ++b;	// already present
+				keys.push_back(std::move_if_noexcept(this->keyArray[a]));
+				values.push_back(std::move_if_noexcept(this->valueArray[a]));
+				++a;
+			}
+		}
+		for(; a != this->keyArray.size(); a++)
+		{
+			keys.push_back(std::move_if_noexcept(this->keyArray[a]));
+			values.push_back(std::move_if_noexcept(this->valueArray[a]));
+		}
+		for(; b != batch.end(); ++b)
+		{
+			keys.push_back(std::move(b->first));
+			values.push_back(std::move(b->second));
+		}
+		this->keyArray.swap(keys);
+		this->valueArray.swap(values);
+	}
+} // end of namespace GT
+#endif // IFLATMAP_H
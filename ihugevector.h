@@ -0,0 +1,140 @@
+/*--------------------------------------------------------------------------------------------------*/
+/*      Autor: Georgios Terzoglou                                                                   */
+/*      Copyright (©) 2014 by Georgios Terzoglou                                                    */
+/*      Bug-reports and suggestions to georgios.terzoglou@googlemail.com                            */
+/*                                                                                                  */
+/*      GENERAL NOTE: I assume no liability for any damages with this header.                       */
+/*      Using this header at your own risk.                                                         */
+/*                                                                                                  */
+/*      Template class: huge_allocator<T, THRESHOLD>, alias iHugeVector<T, GrowthPolicy>            */
+/*                                                                                                  */
+/*      An allocator for iVectors of many gigabytes. Arrays of at least THRESHOLD bytes are         */
+/*      anonymous memory mappings: they grow and shrink with mremap, which moves page table         */
+/*      entries instead of copying the elements, so growing never needs twice the memory and        */
+/*      no copy pass runs. The mappings are advised to use transparent huge pages. Smaller          */
+/*      arrays come from malloc like with GT::allocator. Trivially relocatable elements use         */
+/*      reallocate (see GT::allocator), all others are moved as usual. On systems without           */
+/*      mremap every array comes from malloc. The iVector interface is unchanged:                   */
+/*          GT::iHugeVector<uint64_t> ids;   // GT::iVector<uint64_t, GrowthPolicy, huge_allocator> */
+/*--------------------------------------------------------------------------------------------------*/
+
+#ifndef IHUGEVECTOR_H
+#define IHUGEVECTOR_H
+
+#include "ivector.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#define GT_HAS_MREMAP
+#endif
+
+namespace GT
+{
+	template<class T, size_t THRESHOLD = (size_t(32) << 20)> struct huge_allocator
+	{
+		typedef T value_type;
+		typedef std::true_type propagate_on_container_move_assignment;
+		typedef std::true_type is_always_equal;
+		template<class Y> struct rebind{typedef huge_allocator<Y, THRESHOLD> other;};
+
+		inline huge_allocator(void) noexcept{}
+		template<class Y> inline huge_allocator(const huge_allocator<Y, THRESHOLD> &) noexcept{}
+
+		/* Returns true if an array of n objects is a memory mapping */
+		static inline bool mapped(const size_t n)
+		{
+            #ifdef GT_HAS_MREMAP
+			return sizeof(T) * n >= THRESHOLD;
+            #else
+			GT_UNUSED(n);
+			return false;
+            #endif
+		}
+
+		/* Returns uninitialized storage for n objects. Throws std::bad_alloc if out of memory. */
+		inline T *allocate(const size_t n)
+		{
+			if(n > size_t(-1) / sizeof(T)) throw std::bad_alloc();
+			void *p = mapped(n) ? map(sizeof(T) * n) : std::malloc(sizeof(T) * (n != 0 ? n : 1));
+			if(p == null_ptr) throw std::bad_alloc();
+			return static_cast<T *>(p);
+		}
+
+		/* Releases storage of allocate(n). */
+		inline void deallocate(T *p, const size_t n) noexcept
+		{
+            #ifdef GT_HAS_MREMAP
+			if(mapped(n))
+			{
+				::munmap(static_cast<void *>(p), sizeof(T) * n);
+				return;
+			}
+            #endif
+			std::free(static_cast<void *>(p));
+		}
+
+		/* Resizes storage of allocate(oldN) to newN objects and keeps the bytes of the content.
+		 * Mappings are remapped without a copy, shrinking returns the pages behind the new end
+		 * to the system. Only valid for trivially relocatable T. Returns null if out of memory,
+		 * p stays valid then. */
+		inline T *reallocate(T *p, const size_t oldN, const size_t newN) noexcept
+		{
+			if(newN > size_t(-1) / sizeof(T)) return null_ptr;
+			const size_t oldBytes = sizeof(T) * oldN, newBytes = sizeof(T) * (newN != 0 ? newN : 1);
+			if(!mapped(oldN) && !mapped(newN))
+				return static_cast<T *>(std::realloc(static_cast<void *>(p), newBytes));
+            #ifdef GT_HAS_MREMAP
+			if(mapped(oldN) && mapped(newN))
+			{
+				void *q = ::mremap(static_cast<void *>(p), oldBytes, newBytes, MREMAP_MAYMOVE);
+				if(q == MAP_FAILED) return null_ptr;
+				if(newBytes > oldBytes) advise(q, newBytes);
+				return static_cast<T *>(q);
+			}
+            #endif
+			// crosses THRESHOLD: the smaller side is copied once
+			void *q = mapped(newN) ? map(newBytes) : std::malloc(newBytes);
+			if(q == null_ptr) return null_ptr;
+			if(oldN != 0) std::memcpy(q, static_cast<const void *>(p), oldBytes < newBytes ? oldBytes : newBytes);
+			this->deallocate(p, oldN);
+			return static_cast<T *>(q);
+		}
+
+		private:
+			/* Returns a new anonymous mapping of bytes, null if out of memory */
+			static inline void *map(const size_t bytes)
+			{
+                #ifdef GT_HAS_MREMAP
+				void *p = ::mmap(null_ptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+				if(p == MAP_FAILED) return null_ptr;
+				advise(p, bytes);
+				return p;
+                #else
+				return std::malloc(bytes);
+                #endif
+			}
+
+			/* Asks for transparent huge pages, only a hint */
+			static inline void advise(void *p, const size_t bytes)
+			{
+                #if defined(GT_HAS_MREMAP) && defined(MADV_HUGEPAGE)
+				::madvise(p, bytes, MADV_HUGEPAGE);
+                #else
+				GT_UNUSED(p); GT_UNUSED(bytes);
+                #endif
+			}
+	};
+
+	template<class T, class Y, size_t S> inline bool operator==(const huge_allocator<T, S> &, const huge_allocator<Y, S> &){return true;}
+	template<class T, class Y, size_t S> inline bool operator!=(const huge_allocator<T, S> &, const huge_allocator<Y, S> &){return false;}
+
+	namespace detail
+	{
+		template<class T, size_t S> struct is_plain_allocator<huge_allocator<T, S> >: std::true_type{};
+	} // end of namespace detail
+
+	/* An iVector for arrays of many gigabytes, see huge_allocator. */
+	template<class T, class GrowthPolicy = default_growth>
+	using iHugeVector = iVector<T, GrowthPolicy, huge_allocator<T> >;
+} // end of namespace GT
+#endif // IHUGEVECTOR_H
@@ -0,0 +1,412 @@
+/*--------------------------------------------------------------------------------------------------*/
+/*      Autor: Georgios Terzoglou                                                                   */
+/*      Copyright (©) 2014 by Georgios Terzoglou                                                    */
+/*      Bug-reports and suggestions to georgios.terzoglou@googlemail.com                            */
+/*                                                                                                  */
+/*      GENERAL NOTE: I assume no liability for any damages with this header.                       */
+/*      Using this header at your own risk.                                                         */
+/*                                                                                                  */
+/*      Template class: iMappedVector<T, GrowthPolicy>                                              */
+/*                                                                                                  */
+/*      iMappedVectors keep a trivially copyable T array in a memory mapped file (POSIX). The       */
+/*      file starts with a header of 64 bytes (magic, version, element size, size, capacity),       */
+/*      the elements follow. Opening an existing file is one mmap call, nothing is read or          */
+/*      rebuilt, and a read-only opening shares the pages of the page cache (zero copy). The        */
+/*      file grows with ftruncate and mremap, the capacity is chosen by the GrowthPolicy (see       */
+/*      ivector.h). Changes reach the file when the pages are written back by the system, flush     */
+/*      forces it with msync. The read API is the one of iVector: operator[], size(), iterators.    */
+/*--------------------------------------------------------------------------------------------------*/
+
+#ifndef IMAPPEDVECTOR_H
+#define IMAPPEDVECTOR_H
+
+#include "ivector.h"
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace GT
+{
+	namespace detail
+	{
+		/* The file header of an iMappedVector, the elements begin behind it */
+		struct mapped_header
+		{
+			char magic[8];			// "GTIVECT"
+			uint32_t version;		// format version, see iMappedVector::VERSION
+			uint32_t elementSize;	// sizeof(T) of the writer
+			uint64_t size;			// number of elements
+			uint64_t capacity;		// number of elements the file has room for
+			uint64_t reserved[4];	// zero, pads the header to 64 bytes
+		};
+	} // end of namespace detail
+
+	template<class T, class GrowthPolicy = default_growth> class iMappedVector
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "iMappedVector needs a trivially copyable T");
+		static_assert(alignof(T) <= sizeof(detail::mapped_header), "the elements must be aligned by the header size");
+
+		private:
+		// Attributes
+			husk_t core;					// important attributes, see class Husk
+			T *objects;						// first element inside the mapping
+			detail::mapped_header *head;	// begin of the mapping
+			size_t bytes;					// length of the mapping, the file may be longer than the capacity
+			int fd;							// the open file, -1 if closed
+			bool readOnly;					// mapped with PROT_READ only
+
+		// Private methods
+
+			/* Returns the file size for capacity elements */
+			static inline size_t file_bytes(const size_t capacity){return sizeof(detail::mapped_header) + sizeof(T) * capacity;}
+
+			/* Resizes the file and the mapping to newCapacity elements. Returns false on error. */
+			inline bool remap(const size_t newCapacity);
+
+			/* Returns false and reports if self is not open for writing */
+			inline bool writable(const char *function) const;
+
+		public:
+			static const uint32_t VERSION = 1;
+
+		// Iterator types
+			typedef T *iterator;
+			typedef const T *const_iterator;
+			typedef reverse_iterator_t<T> reverse_iterator;
+			typedef const reverse_iterator_t<T> const_reverse_iterator;
+
+
+		// Constructors
+
+			/* Creates a closed iMappedVector, see open. */
+			inline iMappedVector(void): core(0, 0, 0, 0), objects(null_ptr), head(null_ptr), bytes(0), fd(-1), readOnly(false){}
+
+			/* Opens or creates the file at path, see open. Check is_open() for errors. */
+			inline explicit iMappedVector(const char *path, const bool readOnly = false):
+				core(0, 0, 0, 0), objects(null_ptr), head(null_ptr), bytes(0), fd(-1), readOnly(false)
+			{
+				this->open(path, readOnly);
+			}
+
+			/* The move ctor takes over the file of src. src is left closed. */
+			inline iMappedVector(iMappedVector<T, GrowthPolicy> &&src) noexcept:
+				core(src.core), objects(src.objects), head(src.head), bytes(src.bytes), fd(src.fd), readOnly(src.readOnly)
+			{
+				src.core.setHusk(0, 0, 0, 0);
+				src.objects = null_ptr; src.head = null_ptr; src.bytes = 0; src.fd = -1;
+			}
+
+			/* A file is mapped once, copy it with assign into another iMappedVector. */
+			iMappedVector(const iMappedVector<T, GrowthPolicy> &) = delete;
+			iMappedVector<T, GrowthPolicy> &operator=(const iMappedVector<T, GrowthPolicy> &) = delete;
+
+
+		// Destructor
+			~iMappedVector(){this->close();}
+
+
+		// Methods
+
+			/* Maps the file at path. A missing or empty file is created with an empty array unless
+			 * readOnly is set. A readOnly file is mapped with PROT_READ: only the const methods may
+			 * be used then. Returns false if the file cannot be mapped or its header does not match T. */
+			inline bool open(const char *path, const bool readOnly = false);
+
+			/* Unmaps and closes the file. The content stays in the file. */
+			inline void close(void);
+
+			/* Writes changed pages back to the file, waits for it unless async is set. Returns false on error. */
+			inline bool flush(const bool async = false);
+
+			/* Returns true if a file is mapped. */
+			inline bool is_open(void) const{return this->fd >= 0;}
+
+			/* Returns true if the file is mapped read-only. */
+			inline bool read_only(void) const{return this->readOnly;}
+
+			/* Replaces the content with the elements of src. */
+			template<class P, class A> inline bool assign(const iVector<T, P, A> &src);
+
+			/* Inserts a copy of x to the end of self. */
+			inline void push_back(const T &x);
+
+			/* Removes the last element of self. */
+			inline void pop_back(void)
+			{
+				if(this->writable("template<class T, class GrowthPolicy> void iMappedVector<T, GrowthPolicy>::pop_back(void);"))
+					this->head->size = --this->core.actualSize;
+			}
+
+			/* Inserts x before position, the tail is shifted. Returns an iterator that points to x. */
+			inline iterator insert(const_iterator position, const T &x);
+
+			/* Deletes the elements in [first, last), the tail is shifted.
+			 * Returns an iterator that points to the element behind the erased ones. */
+			inline iterator erase(const_iterator first, const_iterator last);
+
+			/* Alters the size of self, new elements are value-initialized. */
+			inline void resize(const size_t newSize);
+
+			/* Grows the file to room for newCapacity elements. Returns false on error. */
+			inline bool reserve(const size_t newCapacity);
+
+			/* Cuts the file to the size of the content. */
+			inline void shrink_to_fit(void);
+
+			/* Deletes all elements, the file keeps its capacity. */
+			inline void clear(void){this->resize(0);}
+
+			/* Sorts the elements into ascending order. */
+			inline void sort(void){std::sort(this->begin(), this->end());}
+
+			/* Returns true if the size is zero. */
+			inline bool empty(void) const{return this->core.actualSize == 0;}
+
+			/* Returns the number of elements. */
+			inline size_t size(void) const{return this->core.actualSize;}
+
+			/* Returns the number of elements the file has room for. */
+			inline size_t capacity(void) const{return this->core.actualCapacity;}
+
+			/* Return actual core */
+			inline husk_t getCore(void) const{return this->core;}
+
+			/* Returns a reference to the first element. */
+			inline T &front(void){return this->objects[0];}
+			inline const T &front(void) const{return this->objects[0];}
+
+			/* Returns a reference to the last element. */
+			inline T &back(void){return this->objects[this->core.actualSize - 1];}
+			inline const T &back(void) const{return this->objects[this->core.actualSize - 1];}
+
+			/* Returns a reference to element n of self. If n is out of range the last element is returned. */
+			inline T &at(const size_t index){return this->objects[index < this->core.actualSize ? index : this->core.actualSize - 1];}
+			inline const T &at(const size_t index) const{return this->objects[index < this->core.actualSize ? index : this->core.actualSize - 1];}
+
+
+		// Operators
+
+			/* cast the iMappedVector obj in the basic T* datatype, the elements are contiguous */
+			inline operator T*() const{return this->objects;}
+
+			/* The move assignment closes self and takes over the file of rhs. */
+			inline iMappedVector<T, GrowthPolicy> &operator=(iMappedVector<T, GrowthPolicy> &&rhs) noexcept
+			{
+				if(this != &rhs)
+				{
+					this->close();
+					std::swap(this->core, rhs.core);
+					std::swap(this->objects, rhs.objects);
+					std::swap(this->head, rhs.head);
+					std::swap(this->bytes, rhs.bytes);
+					std::swap(this->fd, rhs.fd);
+					std::swap(this->readOnly, rhs.readOnly);
+				}
+				return *this;
+			}
+
+			/* Returns a reference to element n of self. The index n must be between 0 and the size less one. */
+			inline T &operator[](const size_t index){return this->objects[index];}
+			inline const T &operator[](const size_t index) const{return this->objects[index];}
+
+
+		// Iterators
+			inline iterator begin(void){return this->objects;}
+			inline const_iterator begin(void) const{return this->objects;}
+			inline iterator end(void){return this->objects + this->core.actualSize;}
+			inline const_iterator end(void) const{return this->objects + this->core.actualSize;}
+			inline reverse_iterator rbegin(void){return reverse_iterator(this->objects + this->core.actualSize - 1);}
+			inline const_reverse_iterator rbegin(void) const{return const_reverse_iterator(this->objects + this->core.actualSize - 1);}
+			inline reverse_iterator rend(void){return reverse_iterator(this->objects - 1);}
+			inline const_reverse_iterator rend(void) const{return const_reverse_iterator(this->objects - 1);}
+	};
+
+	template<class T, class GrowthPolicy> bool iMappedVector<T, GrowthPolicy>::open(const char *path, const bool readOnly)
+	{
+		this->close();
+		const int file = ::open(path, readOnly ? O_RDONLY : (O_RDWR | O_CREAT), 0644);
+		struct stat info;
+		if(file < 0 || ::fstat(file, &info) != 0)
+		{
+            #ifdef GT_CERR_ACTIVE
+			std::cerr << "IN FUNCTION: template<class T, class GrowthPolicy> bool iMappedVector<T, GrowthPolicy>::open(const char *path, const bool readOnly);" << std::endl;
+			std::cerr << "CANNOT OPEN THE FILE " << path << "." << std::endl;
+            #endif
+			if(file >= 0) ::close(file);
+			return false;
+		}
+		this->fd = file;
+		this->readOnly = readOnly;
+		this->core.setHusk(0, 0, 0, 0);
+		const size_t initialCapacity = GrowthPolicy::initial(this->core, 0);
+
+		if(info.st_size == 0 && !readOnly)
+		{	// new file: write an empty array
+			if(!this->remap(initialCapacity))
+			{
+				this->close();
+				return false;
+			}
+			std::memset(static_cast<void *>(this->head), 0, sizeof(detail::mapped_header));
+			std::memcpy(this->head->magic, "GTIVECT", 8);
+			this->head->version = VERSION;
+			this->head->elementSize = sizeof(T);
+			this->head->capacity = initialCapacity;
+			return true;
+		}
+
+		const size_t bytes = size_t(info.st_size);
+		void *map = bytes >= sizeof(detail::mapped_header) ?
+				::mmap(null_ptr, bytes, readOnly ? PROT_READ : (PROT_READ | PROT_WRITE), MAP_SHARED, file, 0) : MAP_FAILED;
+		const detail::mapped_header *h = static_cast<const detail::mapped_header *>(map);
+		if(map == MAP_FAILED || std::memcmp(h->magic, "GTIVECT", 8) != 0 || h->version != VERSION
+				|| h->elementSize != sizeof(T) || h->size > h->capacity || h->capacity > (bytes - sizeof(detail::mapped_header)) / sizeof(T))
+		{
+            #ifdef GT_CERR_ACTIVE
+			std::cerr << "IN FUNCTION: template<class T, class GrowthPolicy> bool iMappedVector<T, GrowthPolicy>::open(const char *path, const bool readOnly);" << std::endl;
+			std::cerr << "THE FILE " << path << " IS NO iMappedVector OF THIS DATATYPE." << std::endl;
+            #endif
+			if(map != MAP_FAILED) ::munmap(map, bytes);
+			this->close();
+			return false;
+		}
+		this->head = static_cast<detail::mapped_header *>(map);
+		this->bytes = bytes;
+		this->objects = reinterpret_cast<T *>(this->head + 1);
+		this->core.actualCapacity = size_t(h->capacity);
+		this->core.actualSize = size_t(h->size);
+		return true;
+	}
+
+	template<class T, class GrowthPolicy> void iMappedVector<T, GrowthPolicy>::close(void)
+	{
+		if(this->head != null_ptr) ::munmap(static_cast<void *>(this->head), this->bytes);
+		if(this->fd >= 0) ::close(this->fd);
+		this->core.setHusk(0, 0, 0, 0);
+		this->objects = null_ptr;
+		this->head = null_ptr;
+		this->bytes = 0;
+		this->fd = -1;
+		this->readOnly = false;
+	}
+
+	template<class T, class GrowthPolicy> bool iMappedVector<T, GrowthPolicy>::flush(const bool async)
+	{
+		if(this->head == null_ptr || this->readOnly) return true;
+		return ::msync(static_cast<void *>(this->head), this->bytes, async ? MS_ASYNC : MS_SYNC) == 0;
+	}
+
+	template<class T, class GrowthPolicy> bool iMappedVector<T, GrowthPolicy>::writable(const char *function) const
+	{
+		if(this->fd >= 0 && !this->readOnly) return true;
+        #ifdef GT_CERR_ACTIVE
+		std::cerr << "IN FUNCTION: " << function << std::endl;
+		std::cerr << "THE iMappedVector IS NOT OPEN FOR WRITING." << std::endl;
+        #else
+		GT_UNUSED(function);
+        #endif
+		return false;
+	}
+
+	template<class T, class GrowthPolicy> bool iMappedVector<T, GrowthPolicy>::remap(const size_t newCapacity)
+	{
+		if(newCapacity > (size_t(-1) - sizeof(detail::mapped_header)) / sizeof(T)) return false;
+		const size_t oldBytes = this->head != null_ptr ? this->bytes : 0, newBytes = file_bytes(newCapacity);
+		if(newBytes > oldBytes && ::ftruncate(this->fd, off_t(newBytes)) != 0) return false;
+		void *map;
+		if(this->head == null_ptr)
+			map = ::mmap(null_ptr, newBytes, PROT_READ | PROT_WRITE, MAP_SHARED, this->fd, 0);
+		else
+		{
+            #if defined(__linux__)
+			map = ::mremap(static_cast<void *>(this->head), oldBytes, newBytes, MREMAP_MAYMOVE);
+            #else
+			::munmap(static_cast<void *>(this->head), oldBytes);
+			map = ::mmap(null_ptr, newBytes, PROT_READ | PROT_WRITE, MAP_SHARED, this->fd, 0);
+            #endif
+		}
+		if(map == MAP_FAILED)
+		{
+            #ifdef GT_CERR_ACTIVE
+			std::cerr << "IN FUNCTION: template<class T, class GrowthPolicy> bool iMappedVector<T, GrowthPolicy>::remap(const size_t newCapacity);" << std::endl;
+			std::cerr << "NOT ENOUGHT MEMORY." << std::endl;
+            #endif
+			return false;
+		}
+		this->head = static_cast<detail::mapped_header *>(map);
+		this->bytes = newBytes;
+		this->objects = reinterpret_cast<T *>(this->head + 1);
+		this->head->capacity = newCapacity;
+		this->core.actualCapacity = newCapacity;
+		// a failed cut leaves the file longer than the mapping, self stays valid
+		return newBytes >= oldBytes || ::ftruncate(this->fd, off_t(newBytes)) == 0;
+	}
+
+	template<class T, class GrowthPolicy> bool iMappedVector<T, GrowthPolicy>::reserve(const size_t newCapacity)
+	{
+		if(!this->writable("template<class T, class GrowthPolicy> bool iMappedVector<T, GrowthPolicy>::reserve(const size_t newCapacity);"))
+			return false;
+		return newCapacity <= this->core.actualCapacity || this->remap(newCapacity);
+	}
+
+	template<class T, class GrowthPolicy> void iMappedVector<T, GrowthPolicy>::shrink_to_fit(void)
+	{
+		if(!this->writable("template<class T, class GrowthPolicy> void iMappedVector<T, GrowthPolicy>::shrink_to_fit(void);"))
+			return;
+		if(this->core.actualSize < this->core.actualCapacity) this->remap(this->core.actualSize);
+	}
+
+	template<class T, class GrowthPolicy> template<class P, class A> bool iMappedVector<T, GrowthPolicy>::assign(const iVector<T, P, A> &src)
+	{
+		if(!this->reserve(src.size())) return false;
+		if(!src.empty()) std::memcpy(static_cast<void *>(this->objects), static_cast<const void *>(src.begin()), sizeof(T) * src.size());
+		this->head->size = this->core.actualSize = src.size();
+		return true;
+	}
+
+	template<class T, class GrowthPolicy> void iMappedVector<T, GrowthPolicy>::push_back(const T &x)
+	{
+		this->insert(this->end(), x);
+	}
+
+	template<class T, class GrowthPolicy> typename iMappedVector<T, GrowthPolicy>::iterator
+		iMappedVector<T, GrowthPolicy>::insert(const_iterator position, const T &x)
+	{
+		const size_t index = position - this->begin();
+		if(!this->writable("template<class T, class GrowthPolicy> iterator iMappedVector<T, GrowthPolicy>::insert(const_iterator position, const T &x);"))
+			return this->begin() + index;
+		const T item(x); // x may refer into the mapping
+		if(this->core.actualSize >= this->core.actualCapacity && !this->remap(GrowthPolicy::grow(this->core, this->core.actualSize + 1)))
+			throw std::bad_alloc();
+		std::memmove(static_cast<void *>(this->objects + index + 1), static_cast<const void *>(this->objects + index),
+				sizeof(T) * (this->core.actualSize - index));
+		this->objects[index] = item;
+		this->head->size = ++this->core.actualSize;
+		return this->begin() + index;
+	}
+
+	template<class T, class GrowthPolicy> typename iMappedVector<T, GrowthPolicy>::iterator
+		iMappedVector<T, GrowthPolicy>::erase(const_iterator first, const_iterator last)
+	{
+		const size_t index = first - this->begin();
+		if(first < last && this->writable("template<class T, class GrowthPolicy> iterator iMappedVector<T, GrowthPolicy>::erase(const_iterator first, const_iterator last);"))
+		{
+			std::memmove(static_cast<void *>(this->objects + index), static_cast<const void *>(last),
+					sizeof(T) * (this->end() - last));
+			this->head->size = this->core.actualSize -= last - first;
+		}
+		return this->begin() + index;
+	}
+
+	template<class T, class GrowthPolicy> void iMappedVector<T, GrowthPolicy>::resize(const size_t newSize)
+	{
+		if(newSize > this->core.actualCapacity && !this->reserve(GrowthPolicy::grow(this->core, newSize))) return;
+		if(!this->writable("template<class T, class GrowthPolicy> void iMappedVector<T, GrowthPolicy>::resize(const size_t newSize);"))
+			return;
+		for(size_t i = this->core.actualSize; i < newSize; i++) this->objects[i] = T();
+		this->head->size = this->core.actualSize = newSize;
+	}
+} // end of namespace GT
+#endif // IMAPPEDVECTOR_H
@@ -0,0 +1,471 @@
+/*--------------------------------------------------------------------------------------------------*/
+/*      Autor: Georgios Terzoglou                                                                   */
+/*      Copyright (©) 2014 by Georgios Terzoglou                                                    */
+/*      Bug-reports and suggestions to georgios.terzoglou@googlemail.com                            */
+/*                                                                                                  */
+/*      GENERAL NOTE: I assume no liability for any damages with this header.                       */
+/*      Using this header at your own risk.                                                         */
+/*                                                                                                  */
+/*      Class: thread_pool, execution policy parallel, sort policies parallel_merge_sort and        */
+/*      parallel_radix_sort                                                                         */
+/*                                                                                                  */
+/*      A fork-join thread pool and the sort policies for iVector::sort(policy) and                 */
+/*      iVector::stable_sort(policy). parallel_merge_sort sorts one chunk per thread and merges     */
+/*      the runs with parallel merge path splits, for any T and comparator. parallel_radix_sort     */
+/*      is an LSD radix sort on 8 bit digits for integer and floating point keys: the elements      */
+/*      themselves or the result of a key projection. Both are stable with stable_sort, radix       */
+/*      sort always. Below the threshold they sort serially:                                        */
+/*          v.sort(GT::parallel_merge_sort());                                                      */
+/*          records.sort(GT::parallel_radix_sort(), [](const record &r){return r.id;});             */
+/*      GT::parallel hands the chunks of the parallel members of iVector (top_k, fill, copy_from,   */
+/*      transform, for_each, reduce) to the pool.                                                   */
+/*      Link with -pthread.                                                                         */
+/*--------------------------------------------------------------------------------------------------*/
+
+#ifndef IPARALLEL_H
+#define IPARALLEL_H
+
+#include "ivector.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+#include <vector>
+#include <deque>
+
+namespace GT
+{
+	/* Class: thread_pool:
+		Runs the tasks of one call of run() on the workers and the calling thread and returns
+		when all are done. Tasks may call run() again, the caller then works on the inner tasks
+		itself, so nesting cannot deadlock. The first exception of a task is rethrown by run().
+	*/
+	class thread_pool
+	{
+		private:
+			struct job
+			{
+				std::function<void(size_t)> fn;
+				size_t tasks;
+				std::atomic<size_t> next, done;
+				std::exception_ptr error;
+				std::mutex errorLock;
+
+				job(const std::function<void(size_t)> &fn, const size_t tasks): fn(fn), tasks(tasks), next(0), done(0){}
+
+				/* Runs tasks until none is left, returns true if this thread finished the last one */
+				inline bool work(void)
+				{
+					bool last = false;
+					for(size_t i; (i = this->next++) < this->tasks;)
+					{
+						try{this->fn(i);}
+						catch(...)
+						{
+							std::lock_guard<std::mutex> lock(this->errorLock);
+							if(!this->error) this->error = std::current_exception();
+						}
+						last = ++this->done == this->tasks;
+					}
+					return last;
+				}
+			};
+
+		// Attributes
+			std::vector<std::thread> workers;
+			std::deque<std::shared_ptr<job> > jobs;
+			std::mutex lock;
+			std::condition_variable wake, finished;
+			bool stop;
+
+			inline void worker(void);
+
+		public:
+		// Constructors
+			/* Starts threads workers, hardware_concurrency() - 1 for 0, since the caller of run works too. */
+			inline explicit thread_pool(size_t threads = 0);
+
+			thread_pool(const thread_pool &) = delete;
+			thread_pool &operator=(const thread_pool &) = delete;
+
+		// Destructor
+			inline ~thread_pool();
+
+		// Methods
+			/* Returns the number of threads of run(), the workers and the caller. */
+			inline size_t size(void) const{return this->workers.size() + 1;}
+
+			/* Calls fn(i) for every i in [0, tasks) and returns when all calls are done. */
+			inline void run(const size_t tasks, const std::function<void(size_t)> &fn);
+
+			/* Returns the pool of the process, started at the first call. */
+			static inline thread_pool &instance(void)
+			{
+				static thread_pool pool;
+				return pool;
+			}
+	};
+
+	thread_pool::thread_pool(size_t threads): stop(false)
+	{
+		if(threads == 0)
+		{
+			const size_t cores = std::thread::hardware_concurrency();
+			threads = cores > 1 ? cores - 1 : 0;
+		}
+		for(size_t i=0; i<threads; i++)
+			this->workers.push_back(std::thread(&thread_pool::worker, this));
+	}
+
+	thread_pool::~thread_pool()
+	{
+		{
+			std::lock_guard<std::mutex> guard(this->lock);
+			this->stop = true;
+		}
+		this->wake.notify_all();
+		for(size_t i=0; i<this->workers.size(); i++) this->workers[i].join();
+	}
+
+	void thread_pool::worker(void)
+	{
+		for(;;)
+		{
+			std::shared_ptr<job> j;
+			{
+				std::unique_lock<std::mutex> guard(this->lock);
+				this->wake.wait(guard, [this]{return this->stop || !this->jobs.empty();});
+				if(this->stop) return;
+				j = this->jobs.front();
+				if(j->next >= j->tasks)
+				{	// all tasks are taken, the threads on them finish it
+					this->jobs.pop_front();
+					continue;
+				}
+			}
+			if(j->work())
+			{
+				std::lock_guard<std::mutex> guard(this->lock);
+				this->finished.notify_all();
+			}
+		}
+	}
+
+	void thread_pool::run(const size_t tasks, const std::function<void(size_t)> &fn)
+	{
+		if(tasks == 0) return;
+		if(tasks == 1 || this->workers.empty())
+		{
+			for(size_t i=0; i<tasks; i++) fn(i);
+			return;
+		}
+		std::shared_ptr<job> j = std::make_shared<job>(fn, tasks);
+		{
+			std::lock_guard<std::mutex> guard(this->lock);
+			this->jobs.push_back(j);
+		}
+		this->wake.notify_all();
+		j->work();
+		{
+			std::unique_lock<std::mutex> guard(this->lock);
+			this->finished.wait(guard, [&j]{return j->done == j->tasks;});
+			for(std::deque<std::shared_ptr<job> >::iterator i = this->jobs.begin(); i != this->jobs.end(); ++i)
+				if(*i == j)
+				{
+					this->jobs.erase(i);
+					break;
+				}
+		}
+		if(j->error) std::rethrow_exception(j->error);
+	}
+
+	namespace detail
+	{
+		/* Move-constructs the stable merge of the sorted runs [a, aEnd) and [b, bEnd) into raw
+		 * storage at out. On ties the element of a comes first. */
+		template<class T, class Compare> inline void merge_construct(T *a, T *aEnd, T *b, T *bEnd, T *out, Compare &comp)
+		{
+			while(a != aEnd && b != bEnd)
+				::new(static_cast<void *>(out++)) T(std::move(comp(*b, *a) ? *b++ : *a++));
+			for(; a != aEnd; ++a, ++out) ::new(static_cast<void *>(out)) T(std::move(*a));
+			for(; b != bEnd; ++b, ++out) ::new(static_cast<void *>(out)) T(std::move(*b));
+		}
+
+		/* Returns how many of the first d elements of the stable merge of a and b come from a */
+		template<class T, class Compare> inline size_t merge_split(const T *a, const size_t na, const T *b, const size_t nb, const size_t d, Compare &comp)
+		{
+			size_t lo = d > nb ? d - nb : 0, hi = d < na ? d : na;
+			while(lo < hi)
+			{
+				const size_t i = lo + (hi - lo) / 2, j = d - i;
+				if(j == 0 || i == na || comp(b[j - 1], a[i])) hi = i;
+				else lo = i + 1;
+			}
+			return lo;
+		}
+
+		/* Sorts [first, last) as runs of one chunk per thread, which are merged pairwise with
+		 * all threads on every round. Elements are moved between the array and a raw buffer. */
+		template<class T, class Compare> void parallel_merge_sort(T *first, T *last, Compare comp, const bool stable, thread_pool &pool)
+		{
+			const size_t n = size_t(last - first), threads = pool.size();
+			T *buffer = allocate_raw<T>(n);
+			if(buffer == null_ptr) throw std::bad_alloc();
+
+			std::vector<size_t> bounds;
+			for(size_t c=0; c<=threads; c++) bounds.push_back(n * c / threads);
+			pool.run(threads, [&](size_t c)
+			{
+				if(stable) std::stable_sort(first + bounds[c], first + bounds[c + 1], comp);
+				else std::sort(first + bounds[c], first + bounds[c + 1], comp);
+			});
+
+			T *src = first, *dst = buffer;
+			while(bounds.size() > 2)
+			{	// one round: run 2p and 2p + 1 become run p of dst, in parts of about n / threads elements
+				const size_t runs = bounds.size() - 1, pairs = (runs + 1) / 2, parts = (threads + pairs - 1) / pairs;
+				// the split points of all parts first: a part compares elements behind its own
+				// range, which the next part moves away once the merging has started
+				std::vector<size_t> splits(pairs * (parts + 1));
+				pool.run(pairs, [&](size_t p)
+				{
+					const size_t aBegin = bounds[2 * p], aEnd = bounds[2 * p + 1], bEnd = 2 * p + 2 < bounds.size() ? bounds[2 * p + 2] : aEnd;
+					const size_t na = aEnd - aBegin, nb = bEnd - aEnd, total = na + nb;
+					for(size_t part=0; part<=parts; part++)
+						splits[p * (parts + 1) + part] = merge_split(src + aBegin, na, src + aEnd, nb, total * part / parts, comp);
+				});
+				pool.run(pairs * parts, [&](size_t task)
+				{
+					const size_t p = task / parts, part = task % parts;
+					const size_t aBegin = bounds[2 * p], aEnd = bounds[2 * p + 1], bEnd = 2 * p + 2 < bounds.size() ? bounds[2 * p + 2] : aEnd;
+					const size_t total = bEnd - aBegin;
+					const size_t d0 = total * part / parts, d1 = total * (part + 1) / parts;
+					const size_t i0 = splits[p * (parts + 1) + part], i1 = splits[p * (parts + 1) + part + 1];
+					merge_construct(src + aBegin + i0, src + aBegin + i1, src + aEnd + (d0 - i0), src + aEnd + (d1 - i1), dst + aBegin + d0, comp);
+				});
+				pool.run(threads, [&](size_t c){destroy_range(src + n * c / threads, src + n * (c + 1) / threads);});
+
+				std::vector<size_t> merged;
+				for(size_t i=0; i<bounds.size(); i+=2) merged.push_back(bounds[i]);
+				if(merged.back() != n) merged.push_back(n);
+				bounds.swap(merged);
+				std::swap(src, dst);
+			}
+			if(src != first)
+				pool.run(threads, [&](size_t c)
+				{
+					const size_t b = n * c / threads, e = n * (c + 1) / threads;
+					std::uninitialized_copy(std::make_move_iterator(src + b), std::make_move_iterator(src + e), first + b);
+					destroy_range(src + b, src + e);
+				});
+			deallocate_raw(buffer);
+		}
+
+		/* Maps an arithmetic key to an unsigned integer of the same order */
+		template<class K, bool = std::is_floating_point<K>::value> struct radix_key
+		{
+			typedef typename lane_of_size<sizeof(K)>::type type;
+			static inline type get(const K k)
+			{
+				const type u = type(k);
+				return std::is_signed<K>::value ? type(u ^ (type(1) << (8 * sizeof(K) - 1))) : u;
+			}
+		};
+
+		template<class K> struct radix_key<K, true>
+		{	// negative numbers in reverse order below the positive ones
+			typedef typename lane_of_size<sizeof(K)>::type type;
+			static inline type get(const K k)
+			{
+				type u;
+				std::memcpy(&u, &k, sizeof(K));
+				const type sign = type(1) << (8 * sizeof(K) - 1);
+				return (u & sign) != 0 ? type(~u) : type(u | sign);
+			}
+		};
+
+		/* Returns the element itself as key */
+		struct identity_key
+		{
+			template<class T> inline const T &operator()(const T &x) const{return x;}
+		};
+
+		/* LSD radix sort on 8 bit digits of the key key(x), stable. Each thread counts and scatters
+		 * its own chunk, passes where all keys share the digit are skipped. */
+		template<class T, class Key> void parallel_radix_sort(T *first, T *last, Key key, thread_pool &pool)
+		{
+			typedef typename std::decay<decltype(key(*first))>::type K;
+			static_assert(std::is_arithmetic<K>::value, "parallel_radix_sort needs an integer or floating point key");
+			typedef radix_key<K> map;
+
+			const size_t n = size_t(last - first), threads = pool.size();
+			T *buffer = allocate_raw<T>(n);
+			if(buffer == null_ptr) throw std::bad_alloc();
+			std::vector<size_t> counts(threads * 256);
+
+			T *src = first, *dst = buffer;
+			for(size_t shift=0; shift<8 * sizeof(K); shift+=8)
+			{
+				pool.run(threads, [&](size_t c)
+				{
+					size_t *count = &counts[c * 256];
+					std::fill(count, count + 256, size_t(0));
+					for(T *i = src + n * c / threads, *e = src + n * (c + 1) / threads; i != e; ++i)
+						count[(map::get(key(*i)) >> shift) & 0xff]++;
+				});
+
+				size_t offset = 0, largest = 0;
+				for(size_t digit=0; digit<256; digit++)
+				{	// chunk c writes its digit behind the same digit of the chunks before
+					size_t all = 0;
+					for(size_t c=0; c<threads; c++)
+					{
+						const size_t k = counts[c * 256 + digit];
+						counts[c * 256 + digit] = offset;
+						offset += k;
+						all += k;
+					}
+					if(largest < all) largest = all;
+				}
+				if(largest == n) continue;
+
+				pool.run(threads, [&](size_t c)
+				{
+					size_t *next = &counts[c * 256];
+					T *b = src + n * c / threads, *e = src + n * (c + 1) / threads;
+					for(T *i = b; i != e; ++i)
+						::new(static_cast<void *>(dst + next[(map::get(key(*i)) >> shift) & 0xff]++)) T(std::move(*i));
+					destroy_range(b, e);
+				});
+				std::swap(src, dst);
+			}
+			if(src != first)
+				pool.run(threads, [&](size_t c)
+				{
+					const size_t b = n * c / threads, e = n * (c + 1) / threads;
+					std::uninitialized_copy(std::make_move_iterator(src + b), std::make_move_iterator(src + e), first + b);
+					destroy_range(src + b, src + e);
+				});
+			deallocate_raw(buffer);
+		}
+
+		/* Compares the keys of a projection */
+		template<class Key> struct key_less
+		{
+			Key key;
+			template<class T> inline bool operator()(const T &a, const T &b) const{return this->key(a) < this->key(b);}
+		};
+	} // end of namespace detail
+
+	/* Execution policy for the parallel members of iVector: a range of n elements is split into
+	   chunks of at least grain elements, up to four per thread. Idle threads take the next free
+	   chunk, so a slow chunk does not hold the others back. Chunks of an array start on cache
+	   lines, no two threads write into the same line. */
+	class parallel
+	{
+		private:
+			thread_pool *pool;
+			size_t grain;
+
+		public:
+			inline explicit parallel(thread_pool &pool = thread_pool::instance(), const size_t grain = size_t(1) << 15):
+				pool(&pool), grain(grain != 0 ? grain : 1){}
+
+			/* Returns the number of chunks of n elements. */
+			inline size_t chunks(const size_t n) const
+			{
+				const size_t most = n / this->grain, limit = 4 * this->pool->size();
+				return most < 1 ? 1 : most < limit ? most : limit;
+			}
+
+			/* Calls fn(chunk, begin, end) for the chunks [begin, end) of [0, n). */
+			template<class Fn> inline void run(const size_t n, Fn fn) const
+			{
+				const size_t c = this->chunks(n);
+				this->pool->run(c, [&](size_t i){fn(i, n * i / c, n * (i + 1) / c);});
+			}
+
+			/* The same for the array of n elements at base, with the chunks moved to cache lines.
+			 * Chunks may be empty. */
+			template<class T, class Fn> inline void run(const T *base, const size_t n, Fn fn) const
+			{
+				const size_t c = this->chunks(n);
+				this->pool->run(c, [&](size_t i){fn(i, boundary(base, n * i / c, n), boundary(base, n * (i + 1) / c, n));});
+			}
+
+		private:
+			/* Returns the first index at or behind i which starts a cache line, at most n */
+			template<class T> static inline size_t boundary(const T *base, const size_t i, const size_t n)
+			{
+				const size_t line = 64;
+				if(i == 0 || i >= n || line % sizeof(T) != 0) return i;
+				const uintptr_t at = reinterpret_cast<uintptr_t>(base + i), next = (at + line - 1) & ~uintptr_t(line - 1);
+				const size_t j = i + size_t(next - at) / sizeof(T);
+				return j < n ? j : n;
+			}
+	};
+
+	/* Sort policy: parallel merge sort for any T and comparator. Ranges below threshold elements,
+	   single thread pools and T that may throw on a move are sorted serially with std::sort
+	   (std::stable_sort). The comparator must not throw. */
+	class parallel_merge_sort
+	{
+		private:
+			thread_pool *pool;
+			size_t threshold;
+
+		public:
+			inline explicit parallel_merge_sort(thread_pool &pool = thread_pool::instance(), const size_t threshold = size_t(1) << 16):
+				pool(&pool), threshold(threshold){}
+
+			template<class T> inline void sort(T *first, T *last) const{this->sort(first, last, std::less<T>());}
+			template<class T, class Compare> inline void sort(T *first, T *last, Compare comp) const{this->run(first, last, comp, false);}
+
+			template<class T> inline void stable_sort(T *first, T *last) const{this->stable_sort(first, last, std::less<T>());}
+			template<class T, class Compare> inline void stable_sort(T *first, T *last, Compare comp) const{this->run(first, last, comp, true);}
+
+		private:
+			template<class T, class Compare> inline void run(T *first, T *last, Compare comp, const bool stable) const
+			{
+				if(size_t(last - first) < this->threshold || this->pool->size() < 2 || !std::is_nothrow_move_constructible<T>::value)
+				{
+					if(stable) std::stable_sort(first, last, comp);
+					else std::sort(first, last, comp);
+				}
+				else detail::parallel_merge_sort(first, last, comp, stable, *this->pool);
+			}
+	};
+
+	/* Sort policy: parallel LSD radix sort for integer and floating point elements, or for any T
+	   with the key projection key(x) of such a type. The order is that of operator< on the keys,
+	   NaNs go to the ends by their sign bit. Always stable. Ranges below threshold elements and T
+	   that may throw on a move are sorted with std::stable_sort on the keys. */
+	class parallel_radix_sort
+	{
+		private:
+			thread_pool *pool;
+			size_t threshold;
+
+		public:
+			inline explicit parallel_radix_sort(thread_pool &pool = thread_pool::instance(), const size_t threshold = size_t(1) << 12):
+				pool(&pool), threshold(threshold){}
+
+			template<class T> inline void sort(T *first, T *last) const{this->sort(first, last, detail::identity_key());}
+			template<class T, class Key> inline void sort(T *first, T *last, Key key) const
+			{
+				if(size_t(last - first) < this->threshold || !std::is_nothrow_move_constructible<T>::value)
+				{
+					const detail::key_less<Key> less = {key};
+					std::stable_sort(first, last, less);
+				}
+				else detail::parallel_radix_sort(first, last, key, *this->pool);
+			}
+
+			template<class T> inline void stable_sort(T *first, T *last) const{this->sort(first, last);}
+			template<class T, class Key> inline void stable_sort(T *first, T *last, Key key) const{this->sort(first, last, key);}
+	};
+} // end of namespace GT
+#endif // IPARALLEL_H
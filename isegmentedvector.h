@@ -0,0 +1,397 @@
+/*--------------------------------------------------------------------------------------------------*/
+/*      Autor: Georgios Terzoglou                                                                   */
+/*      Copyright (©) 2014 by Georgios Terzoglou                                                    */
+/*      Bug-reports and suggestions to georgios.terzoglou@googlemail.com                            */
+/*                                                                                                  */
+/*      GENERAL NOTE: I assume no liability for any damages with this header.                       */
+/*      Using this header at your own risk.                                                         */
+/*                                                                                                  */
+/*      Template class: iSegmentedVector<T, SHIFT>                                                  */
+/*                                                                                                  */
+/*      A vector for huge, growing datasets. The elements live in chunks of 2^SHIFT elements        */
+/*      (about 64 KiB by default) which are listed in a small chunk directory. Growing adds a       */
+/*      chunk and never moves the elements, so push_back has no copy stall, needs no second         */
+/*      array and pointers and references to elements stay valid until they are erased.             */
+/*      operator[] finds an element with one shift and one mask. The iterators are random access    */
+/*      and hold an index, so they survive push_back as well.                                       */
+/*--------------------------------------------------------------------------------------------------*/
+
+#ifndef ISEGMENTEDVECTOR_H
+#define ISEGMENTEDVECTOR_H
+
+#include "ivector.h"
+
+namespace GT
+{
+	namespace detail
+	{
+		/* The smallest shift whose chunk of 2^shift objects of BYTES bytes holds at least 64 KiB */
+		template<size_t BYTES, size_t SHIFT = 0, bool = (BYTES << SHIFT) >= (size_t(1) << 16)> struct segment_shift
+		{
+			static const size_t value = segment_shift<BYTES, (SHIFT + 1)>::value;
+		};
+
+		template<size_t BYTES, size_t SHIFT> struct segment_shift<BYTES, SHIFT, true>
+		{
+			static const size_t value = SHIFT;
+		};
+
+		/* Random access iterator of a segmented container: the container and an index.
+		 * V is the value type, const for the const_iterator. */
+		template<class Container, class V> class segment_iterator
+		{
+			template<class, class> friend class segment_iterator;
+
+			private:
+				Container *owner;
+				size_t index;
+
+			public:
+				typedef std::random_access_iterator_tag iterator_category;
+				typedef typename std::remove_const<V>::type value_type;
+				typedef std::ptrdiff_t difference_type;
+				typedef V *pointer;
+				typedef V &reference;
+
+				inline segment_iterator(void): owner(null_ptr), index(0){}
+				inline segment_iterator(Container *owner, const size_t index): owner(owner), index(index){}
+
+				/* iterator to const_iterator */
+				template<class C, class Y, class = typename std::enable_if<std::is_convertible<C *, Container *>::value>::type>
+				inline segment_iterator(const segment_iterator<C, Y> &src): owner(src.owner), index(src.index){}
+
+				/* Returns the index of the element in the container */
+				inline size_t position(void) const{return this->index;}
+
+				inline reference operator*(void) const{return (*this->owner)[this->index];}
+				inline pointer operator->(void) const{return &(*this->owner)[this->index];}
+				inline reference operator[](const difference_type n) const{return (*this->owner)[this->index + n];}
+
+				inline segment_iterator &operator++(void){++this->index; return *this;}
+				inline segment_iterator &operator--(void){--this->index; return *this;}
+				inline segment_iterator operator++(int){segment_iterator old(*this); ++this->index; return old;}
+				inline segment_iterator operator--(int){segment_iterator old(*this); --this->index; return old;}
+				inline segment_iterator &operator+=(const difference_type n){this->index += n; return *this;}
+				inline segment_iterator &operator-=(const difference_type n){this->index -= n; return *this;}
+				inline segment_iterator operator+(const difference_type n) const{return segment_iterator(this->owner, this->index + n);}
+				inline segment_iterator operator-(const difference_type n) const{return segment_iterator(this->owner, this->index - n);}
+				friend inline segment_iterator operator+(const difference_type n, const segment_iterator &it){return it + n;}
+
+				template<class C, class Y> inline difference_type operator-(const segment_iterator<C, Y> &it) const{return difference_type(this->index - it.index);}
+				template<class C, class Y> inline bool operator==(const segment_iterator<C, Y> &it) const{return this->index == it.index;}
+				template<class C, class Y> inline bool operator!=(const segment_iterator<C, Y> &it) const{return this->index != it.index;}
+				template<class C, class Y> inline bool operator<(const segment_iterator<C, Y> &it) const{return this->index < it.index;}
+				template<class C, class Y> inline bool operator>(const segment_iterator<C, Y> &it) const{return this->index > it.index;}
+				template<class C, class Y> inline bool operator<=(const segment_iterator<C, Y> &it) const{return this->index <= it.index;}
+				template<class C, class Y> inline bool operator>=(const segment_iterator<C, Y> &it) const{return this->index >= it.index;}
+		};
+	} // end of namespace detail
+
+	template<class T, size_t SHIFT = detail::segment_shift<sizeof(T)>::value> class iSegmentedVector
+	{
+		static_assert(SHIFT < 8 * sizeof(size_t), "the chunk size of iSegmentedVector must fit into size_t");
+
+		public:
+			static const size_t chunk_size = size_t(1) << SHIFT;
+
+		// Iterator types
+			typedef detail::segment_iterator<iSegmentedVector<T, SHIFT>, T> iterator;
+			typedef detail::segment_iterator<const iSegmentedVector<T, SHIFT>, const T> const_iterator;
+			typedef std::reverse_iterator<iterator> reverse_iterator;
+			typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+		// Container types
+			typedef T value_type;
+
+		private:
+		// Attributes
+			static const size_t MASK = chunk_size - 1;
+
+			iVector<T *> directory;	// the chunks, never moved
+			size_t actualSize;
+
+		// Private methods
+			/* Appends a chunk to the directory, throws std::bad_alloc if out of memory */
+			inline void add_chunk(void);
+
+			/* Returns the number of chunks that hold elements */
+			inline size_t used_chunks(void) const{return (this->actualSize + MASK) >> SHIFT;}
+
+			/* Returns the number of elements in chunk c */
+			inline size_t chunk_fill(const size_t c) const
+			{
+				return this->actualSize - (c << SHIFT) < chunk_size ? this->actualSize - (c << SHIFT) : chunk_size;
+			}
+
+		public:
+
+		// Constructors
+
+			/* Creates an empty iSegmentedVector. No memory is allocated. */
+			inline iSegmentedVector(void): actualSize(0){}
+
+			/* Creates a iSegmentedVector of length n, containing n copies of value. */
+			inline explicit iSegmentedVector(const T &src, const size_t size = 1): actualSize(0)
+			{
+				try
+				{
+					this->reserve(size);
+					for(size_t i=0; i<size; i++) this->push_back(src);
+				}
+				catch(...)
+				{	// the destructor does not run
+					this->clear();
+					this->shrink_to_fit();
+					throw;
+				}
+			}
+
+			inline iSegmentedVector(const iSegmentedVector<T, SHIFT> &src): actualSize(0)
+			{
+				try
+				{
+					this->reserve(src.size());
+					for(size_t c=0; c<src.used_chunks(); c++)
+						for(size_t i=0; i<src.chunk_fill(c); i++) this->push_back(src.directory[c][i]);
+				}
+				catch(...)
+				{	// the destructor does not run
+					this->clear();
+					this->shrink_to_fit();
+					throw;
+				}
+			}
+
+			inline iSegmentedVector(iSegmentedVector<T, SHIFT> &&src): directory(std::move(src.directory)), actualSize(src.actualSize)
+			{
+				src.actualSize = 0;
+			}
+
+		// Destructor
+			~iSegmentedVector(){this->clear(); this->shrink_to_fit();}
+
+		// Operators
+			inline iSegmentedVector<T, SHIFT> &operator=(const iSegmentedVector<T, SHIFT> &src)
+			{
+				if(this != &src)
+				{
+					iSegmentedVector<T, SHIFT> copy(src);
+					this->swap(copy);
+				}
+				return *this;
+			}
+
+			inline iSegmentedVector<T, SHIFT> &operator=(iSegmentedVector<T, SHIFT> &&src)
+			{
+				this->swap(src);
+				return *this;
+			}
+
+			/* Returns the element at index, one shift and one mask. No bounds check, see at(). */
+			inline T &operator[](const size_t index){return this->directory[index >> SHIFT][index & MASK];}
+			inline const T &operator[](const size_t index) const{return this->directory[index >> SHIFT][index & MASK];}
+
+		// Methods
+			/* Appends x. Adds a chunk if the last one is full, the elements are never moved,
+			 * so x may refer to an element of self. */
+			inline void push_back(const T &x){this->emplace_back(x);}
+			inline void push_back(T &&x){this->emplace_back(std::move(x));}
+
+			/* Constructs an element with args at the end and returns it. */
+			template<class... Args> inline T &emplace_back(Args&&... args)
+			{
+				if(this->actualSize == this->capacity()) this->add_chunk();
+				T *p = this->directory[this->actualSize >> SHIFT] + (this->actualSize & MASK);
+				::new(static_cast<void *>(p)) T(std::forward<Args>(args)...);
+				this->actualSize++;
+				return *p;
+			}
+
+			/* Removes the last element. The chunk is kept, see shrink_to_fit(). */
+			inline void pop_back(void){this->operator[](--this->actualSize).~T();}
+
+			/* Returns the element at index with a bounds check like iVector::at. */
+			inline T &at(const size_t index);
+			inline const T &at(const size_t index) const{return const_cast<iSegmentedVector<T, SHIFT> *>(this)->at(index);}
+
+			inline T &front(void){return this->operator[](0);}
+			inline const T &front(void) const{return this->operator[](0);}
+			inline T &back(void){return this->operator[](this->actualSize - 1);}
+			inline const T &back(void) const{return this->operator[](this->actualSize - 1);}
+
+			/* Returns the number of elements. */
+			inline size_t size(void) const{return this->actualSize;}
+
+			/* Returns true if the size is zero. */
+			inline bool empty(void) const{return this->actualSize == 0;}
+
+			/* Returns the number of elements that fit into the allocated chunks. */
+			inline size_t capacity(void) const{return this->directory.size() << SHIFT;}
+
+			/* Allocates chunks until capacity() >= newCapacity. The elements are not moved. */
+			inline void reserve(const size_t newCapacity)
+			{
+				while(this->capacity() < newCapacity) this->add_chunk();
+			}
+
+			/* Alters the size of self, appends value-initialized elements or erases elements off the end. */
+			inline void resize(const size_t newSize)
+			{
+				this->reserve(newSize);
+				while(this->actualSize > newSize) this->pop_back();
+				while(this->actualSize < newSize) this->emplace_back();
+			}
+
+			/* Destroys all elements, keeps the chunks. */
+			inline void clear(void){while(this->actualSize != 0) this->pop_back();}
+
+			/* Frees the chunks behind the last element. */
+			inline void shrink_to_fit(void);
+
+			/* Swaps the content of self and src in constant time. */
+			inline void swap(iSegmentedVector<T, SHIFT> &src)
+			{
+				this->directory.swap(src.directory);
+				std::swap(this->actualSize, src.actualSize);
+			}
+
+			/* Inserts x in front of position and shifts the tail by one element. Linear time. */
+			inline iterator insert(const_iterator position, const T &x)
+			{
+				const size_t index = position.position();
+				this->emplace_back(x);
+				std::rotate(this->begin() + index, this->end() - 1, this->end());
+				return this->begin() + index;
+			}
+
+			/* Deletes the elements in [first, last) and shifts the tail in place.
+			 * Returns an iterator that points to the element behind the erased ones. */
+			inline iterator erase(const_iterator first, const_iterator last)
+			{
+				const size_t index = first.position(), pieces = last - first;
+				std::move(this->begin() + index + pieces, this->end(), this->begin() + index);
+				for(size_t i=0; i<pieces; i++) this->pop_back();
+				return this->begin() + index;
+			}
+			inline iterator erase(const_iterator position){return this->erase(position, position + 1);}
+
+			/* Sorts the elements in ascending order. */
+			inline void sort(void){std::sort(this->begin(), this->end());}
+			template<class Compare> inline void sort(Compare comp){std::sort(this->begin(), this->end(), comp);}
+
+			/* Reverses the order of the elements. */
+			inline void mirror(void){std::reverse(this->begin(), this->end());}
+
+			/* Searches chunk by chunk like the iVector members, arithmetic elements with SIMD. */
+			inline iterator find(const T &x){return iterator(this, static_cast<const iSegmentedVector<T, SHIFT> *>(this)->find(x).position());}
+			inline const_iterator find(const T &x) const;
+			inline size_t count(const T &x) const;
+			inline bool contains(const T &x) const{return this->find(x) != this->end();}
+			inline T sum(void) const;
+
+			/* Calls fn(element) for every element, chunk by chunk. */
+			template<class Fn> inline void for_each(Fn fn)
+			{
+				for(size_t c=0; c<this->used_chunks(); c++)
+					for(T *p = this->directory[c], *e = p + this->chunk_fill(c); p != e; ++p) fn(*p);
+			}
+
+			/* Returns the first element of chunk c, chunk_size consecutive elements of which
+			 * min(chunk_size, size() - c * chunk_size) are constructed. */
+			inline T *chunk(const size_t c){return this->directory[c];}
+			inline const T *chunk(const size_t c) const{return this->directory[c];}
+
+			/* Returns the number of allocated chunks. */
+			inline size_t chunks(void) const{return this->directory.size();}
+
+		// Iterators
+			inline iterator begin(void){return iterator(this, 0);}
+			inline const_iterator begin(void) const{return const_iterator(this, 0);}
+			inline const_iterator cbegin(void) const{return const_iterator(this, 0);}
+			inline iterator end(void){return iterator(this, this->actualSize);}
+			inline const_iterator end(void) const{return const_iterator(this, this->actualSize);}
+			inline const_iterator cend(void) const{return const_iterator(this, this->actualSize);}
+			inline reverse_iterator rbegin(void){return reverse_iterator(this->end());}
+			inline const_reverse_iterator rbegin(void) const{return const_reverse_iterator(this->end());}
+			inline reverse_iterator rend(void){return reverse_iterator(this->begin());}
+			inline const_reverse_iterator rend(void) const{return const_reverse_iterator(this->begin());}
+	};
+
+	template<class T, size_t SHIFT> void iSegmentedVector<T, SHIFT>::add_chunk(void)
+	{
+		T *p = detail::allocate_raw<T>(chunk_size);
+		if(p == null_ptr)
+		{
+            #ifdef GT_CERR_ACTIVE
+			std::cerr << "IN FUNCTION: template<class T, size_t SHIFT> void iSegmentedVector<T, SHIFT>::add_chunk(void);" << std::endl;
+			std::cerr << "NOT ENOUGHT MEMORY." << std::endl;
+            #endif
+			throw std::bad_alloc();
+		}
+		try
+		{	// push_back grows the directory by the GrowthPolicy, reserve would grow it by one
+			this->directory.push_back(p);
+		}
+		catch(const std::bad_alloc &)
+		{
+			detail::deallocate_raw(p);
+			throw;
+		}
+	}
+
+	template<class T, size_t SHIFT> T &iSegmentedVector<T, SHIFT>::at(const size_t index)
+	{
+		if(index >= this->actualSize)
+		{
+			if(this->actualSize != 0)
+			{
+                #ifdef GT_CERR_ACTIVE
+				std::cerr << "IN FUNCTION: template<class T, size_t SHIFT> T &iSegmentedVector<T, SHIFT>::at(size_t index);" << std::endl;
+				std::cerr << "Caution: The largest possible index of the \"at()\" function is " << this->actualSize - 1
+						  << " and you have entered the number " << index << " !!!" << std::endl;
+                #endif
+				return this->operator[](this->actualSize - 1);
+			}
+			else
+			{
+				return this->operator[](this->actualSize);
+			}
+		}
+		else return this->operator[](index);
+	}
+
+	template<class T, size_t SHIFT> void iSegmentedVector<T, SHIFT>::shrink_to_fit(void)
+	{
+		while(this->directory.size() > this->used_chunks())
+		{
+			detail::deallocate_raw(this->directory.back());
+			this->directory.pop_back();
+		}
+		this->directory.shrink_to_fit();
+	}
+
+	template<class T, size_t SHIFT> typename iSegmentedVector<T, SHIFT>::const_iterator iSegmentedVector<T, SHIFT>::find(const T &x) const
+	{
+		for(size_t c=0; c<this->used_chunks(); c++)
+		{
+			const size_t n = this->chunk_fill(c), i = detail::search<T>::find(this->directory[c], n, x);
+			if(i != n) return const_iterator(this, (c << SHIFT) + i);
+		}
+		return this->end();
+	}
+
+	template<class T, size_t SHIFT> size_t iSegmentedVector<T, SHIFT>::count(const T &x) const
+	{
+		size_t total = 0;
+		for(size_t c=0; c<this->used_chunks(); c++) total += detail::search<T>::count(this->directory[c], this->chunk_fill(c), x);
+		return total;
+	}
+
+	template<class T, size_t SHIFT> T iSegmentedVector<T, SHIFT>::sum(void) const
+	{
+		T total = T();
+		for(size_t c=0; c<this->used_chunks(); c++) total += detail::search<T>::sum(this->directory[c], this->chunk_fill(c));
+		return total;
+	}
+} // end of namespace GT
+#endif // ISEGMENTEDVECTOR_H
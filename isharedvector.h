@@ -0,0 +1,217 @@
+/*--------------------------------------------------------------------------------------------------*/
+/*      Autor: Georgios Terzoglou                                                                   */
+/*      Copyright (©) 2014 by Georgios Terzoglou                                                    */
+/*      Bug-reports and suggestions to georgios.terzoglou@googlemail.com                            */
+/*                                                                                                  */
+/*      GENERAL NOTE: I assume no liability for any damages with this header.                       */
+/*      Using this header at your own risk.                                                         */
+/*                                                                                                  */
+/*      Template class: shared_ivector<T, GrowthPolicy, Allocator>                                  */
+/*                                                                                                  */
+/*      A copy-on-write iVector for read-mostly data that is copied into many places. Copies        */
+/*      share one buffer with an atomic reference count, so a copy costs O(1) and the memory        */
+/*      grows with the distinct contents, not with the number of readers. The first change          */
+/*      through a copy (push_back, erase, non-const operator[], write() ...) detaches it: the       */
+/*      content is copied once and the other copies keep the old buffer. Reading goes through       */
+/*      the const members or view(), which is a const iVector with all of its search members.      */
+/*--------------------------------------------------------------------------------------------------*/
+
+#ifndef ISHAREDVECTOR_H
+#define ISHAREDVECTOR_H
+
+#include "ivector.h"
+
+#include <atomic>
+
+namespace GT
+{
+	template<class T, class GrowthPolicy = default_growth, class Allocator = GT::allocator<T> > class shared_ivector
+	{
+		public:
+		// Container types
+			typedef T value_type;
+			typedef iVector<T, GrowthPolicy, Allocator> vector_type;
+			typedef typename vector_type::const_iterator const_iterator;
+
+		private:
+		// Attributes
+			/* The shared buffer. It is only changed while refs == 1. */
+			struct block
+			{
+				std::atomic<size_t> refs;
+				vector_type data;
+
+				inline block(void): refs(1){}
+				inline explicit block(const vector_type &src): refs(1), data(src){}
+				inline explicit block(vector_type &&src): refs(1), data(std::move(src)){}
+			};
+
+			block *shared;	// null if empty and never written
+			bool leaked;	// a mutable reference was handed out, copies must not share
+
+		// Private methods
+			static inline const vector_type &empty_vector(void)
+			{
+				static const vector_type none;
+				return none;
+			}
+
+			static inline void release(block *b)
+			{
+				if(b != null_ptr && b->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete b;
+			}
+
+			/* Makes self the only owner of its buffer, copies the content if it is shared */
+			inline vector_type &detach(void)
+			{
+				if(this->shared == null_ptr) this->shared = new block();
+				else if(this->shared->refs.load(std::memory_order_acquire) != 1)
+				{
+					block *own = new block(this->shared->data);
+					release(this->shared);
+					this->shared = own;
+				}
+				return this->shared->data;
+			}
+
+			/* Like detach, and copies of self get their own buffer from now on */
+			inline vector_type &leak(void)
+			{
+				vector_type &data = this->detach();
+				this->leaked = true;
+				return data;
+			}
+
+		public:
+
+		// Constructors
+
+			/* Creates an empty shared_ivector. No memory is allocated. */
+			inline shared_ivector(void): shared(null_ptr), leaked(false){}
+
+			/* Creates a shared_ivector with the content of src */
+			inline explicit shared_ivector(const vector_type &src): shared(new block(src)), leaked(false){}
+			inline explicit shared_ivector(vector_type &&src): shared(new block(std::move(src))), leaked(false){}
+
+			/* Shares the buffer of src in O(1). After a mutable reference into src was handed out
+			 * (see write()), the content is copied instead. */
+			inline shared_ivector(const shared_ivector<T, GrowthPolicy, Allocator> &src): shared(src.shared), leaked(false)
+			{
+				if(src.leaked) this->shared = new block(src.shared->data);
+				else if(this->shared != null_ptr) this->shared->refs.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			inline shared_ivector(shared_ivector<T, GrowthPolicy, Allocator> &&src) noexcept: shared(src.shared), leaked(src.leaked)
+			{
+				src.shared = null_ptr;
+				src.leaked = false;
+			}
+
+		// Destructor
+			~shared_ivector(){release(this->shared);}
+
+		// Operators
+			inline shared_ivector<T, GrowthPolicy, Allocator> &operator=(const shared_ivector<T, GrowthPolicy, Allocator> &src)
+			{
+				if(this != &src)
+				{
+					shared_ivector<T, GrowthPolicy, Allocator> copy(src);
+					this->swap(copy);
+				}
+				return *this;
+			}
+
+			inline shared_ivector<T, GrowthPolicy, Allocator> &operator=(shared_ivector<T, GrowthPolicy, Allocator> &&src) noexcept
+			{
+				this->swap(src);
+				return *this;
+			}
+
+			/* Reads the element at index, does not detach */
+			inline const T &operator[](const size_t index) const{return this->view()[index];}
+
+			/* Detaches and returns the element at index for writing. Readers of a non-const
+			 * shared_ivector use view()[index] to keep sharing. */
+			inline T &operator[](const size_t index){return this->leak()[index];}
+
+			/* All const members of iVector, e.g. v->find(x) or v->sum() */
+			inline const vector_type *operator->(void) const{return &this->view();}
+
+		// Methods
+			/* Returns the content for reading. Never copies. */
+			inline const vector_type &view(void) const{return this->shared != null_ptr ? this->shared->data : empty_vector();}
+
+			/* Detaches and returns the content for writing. References and iterators into it stay
+			 * valid, so copies made afterwards get their own buffer instead of sharing this one. */
+			inline vector_type &write(void){return this->leak();}
+
+			/* Returns the number of shared_ivectors that share the buffer of self, 0 if it has none */
+			inline size_t use_count(void) const{return this->shared != null_ptr ? this->shared->refs.load(std::memory_order_acquire) : 0;}
+
+			/* Returns true if no other shared_ivector shares the buffer of self */
+			inline bool unique(void) const{return this->use_count() <= 1;}
+
+			inline size_t size(void) const{return this->view().size();}
+			inline bool empty(void) const{return this->view().empty();}
+			inline size_t capacity(void) const{return this->view().capacity();}
+
+			inline const T &at(const size_t index) const{return this->view().at(index);}
+			inline T &at(const size_t index){return this->leak().at(index);}
+			inline const T &front(void) const{return this->view().front();}
+			inline const T &back(void) const{return this->view().back();}
+
+			/* The changing members detach first. They return nothing mutable, so copies still share. */
+			inline void push_back(const T &x){this->detach().push_back(x);}
+			inline void push_back(T &&x){this->detach().push_back(std::move(x));}
+			template<class... Args> inline const T &emplace_back(Args&&... args){return this->detach().emplace_back(std::forward<Args>(args)...);}
+			inline void pop_back(void){this->detach().pop_back();}
+
+			/* Inserts x in front of position, an iterator of view() */
+			inline void insert(const_iterator position, const T &x)
+			{
+				const size_t index = position - this->view().begin();
+				vector_type &data = this->detach();
+				data.insert(data.begin() + index, x);
+			}
+
+			/* Deletes the elements in [first, last), iterators of view() */
+			inline void erase(const_iterator first, const_iterator last)
+			{
+				const size_t index = first - this->view().begin(), pieces = last - first;
+				vector_type &data = this->detach();
+				data.erase(data.begin() + index, data.begin() + index + pieces);
+			}
+			inline void erase(const_iterator position){this->erase(position, position + 1);}
+
+			inline void resize(const size_t newSize){this->detach().resize(newSize);}
+			inline void reserve(const size_t newCapacity){this->detach().reserve(newCapacity);}
+			inline void shrink_to_fit(void){this->detach().shrink_to_fit();}
+			inline void sort(void){this->detach().sort();}
+
+			/* Empties self. A shared buffer is just let go, not copied. */
+			inline void clear(void)
+			{
+				if(this->unique() && this->shared != null_ptr) this->shared->data.clear();
+				else
+				{
+					release(this->shared);
+					this->shared = null_ptr;
+				}
+				this->leaked = false;
+			}
+
+			/* Swaps the content of self and src in constant time. */
+			inline void swap(shared_ivector<T, GrowthPolicy, Allocator> &src) noexcept
+			{
+				std::swap(this->shared, src.shared);
+				std::swap(this->leaked, src.leaked);
+			}
+
+		// Iterators, reading only. Use write() for mutable iterators.
+			inline const_iterator begin(void) const{return this->view().begin();}
+			inline const_iterator end(void) const{return this->view().end();}
+			inline const_iterator cbegin(void) const{return this->view().begin();}
+			inline const_iterator cend(void) const{return this->view().end();}
+	};
+} // end of namespace GT
+#endif // ISHAREDVECTOR_H
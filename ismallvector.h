@@ -0,0 +1,493 @@
+/*--------------------------------------------------------------------------------------------------*/
+/*      Autor: Georgios Terzoglou                                                                   */
+/*      Copyright (©) 2014 by Georgios Terzoglou                                                    */
+/*      Bug-reports and suggestions to georgios.terzoglou@googlemail.com                            */
+/*                                                                                                  */
+/*      GENERAL NOTE: I assume no liability for any damages with this header.                       */
+/*      Using this header at your own risk.                                                         */
+/*                                                                                                  */
+/*      Template class: iSmallVector<T, N, GrowthPolicy>                                            */
+/*                                                                                                  */
+/*      iSmallVectors are iVectors with storage for N elements inside the object itself. As long    */
+/*      as at most N elements are held, no heap memory is used at all: creating, filling and        */
+/*      destroying a short-lived iSmallVector costs no allocation. Beyond N elements the elements   */
+/*      spill into a heap array like in an iVector, the inline buffer counts as the first           */
+/*      reservation of the GrowthPolicy (see ivector.h). shrink_to_fit moves the elements back      */
+/*      into the inline buffer once they fit again. The elements are always contiguous, so          */
+/*      operator T*(), begin() and end() can be used like those of iVector.                         */
+/*--------------------------------------------------------------------------------------------------*/
+
+#ifndef ISMALLVECTOR_H
+#define ISMALLVECTOR_H
+
+#include "ivector.h"
+
+namespace GT
+{
+	template<class T, size_t N = 8, class GrowthPolicy = default_growth> class iSmallVector
+	{
+		static_assert(N > 0, "iSmallVector needs room for at least one inline element");
+
+		private:
+		// Attributes
+			husk_t core;	// important attributes, see class Husk
+			T *objects;		// the inline buffer or a heap array
+			alignas(T) unsigned char buffer[sizeof(T) * N]; // inline storage for N elements
+
+		// Private methods
+
+			/* Returns the inline buffer */
+			inline T *inline_array(void){return reinterpret_cast<T *>(this->buffer);}
+			inline const T *inline_array(void) const{return reinterpret_cast<const T *>(this->buffer);}
+
+			/* Returns the capacity after the next growth step of the GrowthPolicy */
+			inline size_t grown_capacity(const size_t required){return GrowthPolicy::grow(this->core, required);}
+
+			/* Moves the elements to the inline buffer if newCapacity <= N, otherwise to a heap array
+			 * of newCapacity. Returns false if out of memory. */
+			inline bool reallocate(const size_t newCapacity);
+
+			/* Opens [index, index + count) as unconstructed storage and shifts the tail behind it.
+			 * Reallocates at most once. The size is not changed. Returns a pointer to the gap. */
+			inline T *make_gap(const size_t index, const size_t count);
+
+			/* Moves the elements of rhs into self, self must be empty. rhs is left empty. */
+			inline void take(iSmallVector<T, N, GrowthPolicy> &rhs);
+
+		public:
+
+		// Iterator types
+			typedef T *iterator;
+			typedef const T *const_iterator;
+			typedef reverse_iterator_t<T> reverse_iterator;
+			typedef const reverse_iterator_t<T> const_reverse_iterator;
+
+
+		// Constructors
+
+			/* Creates an empty iSmallVector. Memory is only allocated if initCapacity is greater than N. */
+			inline explicit iSmallVector(const size_t initCapacity = 0): core(0, 0, 0, N)
+			{	// 1. ascending   2. bearingsCount   3. actualSize   4. actualCapacity
+				GrowthPolicy::initial(this->core, 0);
+				this->core.actualCapacity = N;
+				this->objects = this->inline_array();
+				if(initCapacity > N) this->reserve(initCapacity);
+			}
+
+			/* Creates a iSmallVector of length n, containing n copies of value. */
+			inline explicit iSmallVector(const T &src, const size_t size = 1): core(0, 0, 0, N)
+			{
+				GrowthPolicy::initial(this->core, 0);
+				this->core.actualCapacity = N;
+				this->objects = this->inline_array();
+				if(size > N) this->reserve(size);
+				try
+				{
+					std::uninitialized_fill_n(this->objects, size, src);
+				}
+				catch(...)
+				{
+					if(!this->is_inline()) detail::deallocate_raw(this->objects);
+					throw;
+				}
+				this->core.actualSize = size;
+			}
+
+			/* The copy ctor Creates a copy of src. */
+			inline iSmallVector(const iSmallVector<T, N, GrowthPolicy> &src): core(0, 0, 0, N)
+			{
+				GrowthPolicy::initial(this->core, 0);
+				this->core.actualCapacity = N;
+				this->objects = this->inline_array();
+				if(src.size() > N) this->reserve(src.size());
+				try
+				{
+					detail::uninitialized_copy_range(src.begin(), src.end(), this->objects);
+				}
+				catch(...)
+				{
+					if(!this->is_inline()) detail::deallocate_raw(this->objects);
+					throw;
+				}
+				this->core.actualSize = src.size();
+			}
+
+			/* The move ctor takes over the heap array of src, or moves the inline elements. src is left empty. */
+			inline iSmallVector(iSmallVector<T, N, GrowthPolicy> &&src): core(0, 0, 0, N)
+			{
+				GrowthPolicy::initial(this->core, 0);
+				this->core.actualCapacity = N;
+				this->objects = this->inline_array();
+				this->take(src);
+			}
+
+			/* Creates a copy of the elements of an iVector. */
+			template<class P, class A> inline explicit iSmallVector(const iVector<T, P, A> &src): core(0, 0, 0, N)
+			{
+				GrowthPolicy::initial(this->core, 0);
+				this->core.actualCapacity = N;
+				this->objects = this->inline_array();
+				if(src.size() > N) this->reserve(src.size());
+				try
+				{
+					detail::uninitialized_copy_range(src.begin(), src.end(), this->objects);
+				}
+				catch(...)
+				{
+					if(!this->is_inline()) detail::deallocate_raw(this->objects);
+					throw;
+				}
+				this->core.actualSize = src.size();
+			}
+
+
+		// Destructor
+			~iSmallVector();
+
+
+		// Methods
+
+			/* Sorts the elements into ascending order. */
+			inline void sort(void){std::sort(this->begin(), this->end());}
+
+			/* Sorts into descending order if descending is set, without a mirror pass. */
+			inline void sort(const bool descending){iSpan<T>(this->objects, this->size()).sort(descending);}
+
+			/* Sorts into descending order. */
+			inline void sort_reverse(void){this->sort(true);}
+
+			/* Replaces the elements of self with a copy of the elements of src. */
+			inline void assign(const iSmallVector<T, N, GrowthPolicy> &src){this->operator=(src);}
+
+			/* Returns a reference to the first element. */
+			inline T &front(void){return this->objects[0];}
+			inline const T &front(void) const{return this->objects[0];}
+
+			/* Inserts a copy of x to the begin of self. Shifts all elements. */
+			inline void push_front(const T &x){this->emplace(this->begin(), x);}
+
+			/* Constructs an element in place before position, using args as the arguments for its constructor.
+			 * Returns an iterator that points to the new element. */
+			template<class... Args> inline iterator emplace(const_iterator position, Args&&... args);
+
+			/* Inserts a copy of new_item at the index position. */
+			inline void insert(const T new_item, const size_t position = 0)
+			{
+				this->emplace(this->begin() + (position > this->size() ? this->size() : position), new_item);
+			}
+
+			/* Inserts x before position. Returns an iterator that points to the inserted element. */
+			inline iterator insert(const_iterator position, const T &x){return this->emplace(position, x);}
+			inline iterator insert(const_iterator position, T &&x){return this->emplace(position, std::move(x));}
+
+			/* Inserts n copies of x before position. Returns an iterator that points to the first inserted element. */
+			inline iterator insert(const_iterator position, const size_t n, const T &x);
+
+			/* Inserts copies of the elements in the range [first, last) before position.
+			 * Returns an iterator that points to the first inserted element. */
+			template<class InputIterator, class = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+			inline iterator insert(const_iterator position, InputIterator first, InputIterator last);
+
+			/* Deletes the element from the index position begin and deletes any desired number of items. */
+			inline void erase(const size_t begin, const size_t pieces = 1)
+			{
+				if(begin < this->size())
+					this->erase(this->begin() + begin, this->begin() + (this->size() - begin < pieces ? this->size() : begin + pieces));
+			}
+			inline void erase(const_iterator it, const size_t pieces = 1)
+			{
+				if(pieces > 0)
+					if(this->size() != 0 && it >= this->begin() && it < this->end())
+						this->erase(it, it + ((size_t)(this->end() - it) < pieces ? (size_t)(this->end() - it) : pieces));
+			}
+
+			/* Deletes the elements in [first, last) and shifts the tail in place.
+			 * Returns an iterator that points to the element behind the erased ones. */
+			inline iterator erase(const_iterator first, const_iterator last);
+
+			/* Alters the size of self, see iVector::resize. */
+			inline void resize(const size_t newSize);
+
+			/* Increases the capacity of self to at least newCapacity, see iVector::reserve.
+			 * Throws std::bad_alloc if out of memory. */
+			inline void reserve(const size_t newCapacity)
+			{
+				if(newCapacity > this->core.actualCapacity && !this->reallocate(newCapacity)) throw std::bad_alloc();
+			}
+
+			/* Returns true if the size is zero. */
+			inline bool empty(void) const{return this->core.actualSize == 0;}
+
+			/* Returns the number of elements. */
+			inline size_t size(void) const{return this->core.actualSize;}
+
+			/* Returns the number of elements that fit into the current storage, at least N. */
+			inline size_t capacity(void) const{return this->core.actualCapacity;}
+
+			/* Returns true while the elements are stored in the inline buffer. */
+			inline bool is_inline(void) const{return this->objects == this->inline_array();}
+
+			/* Inserts a copy of x to the end of self. */
+			inline void push_back(const T &x){this->emplace_back(x);}
+
+			/* Moves x to the end of self. */
+			inline void push_back(T &&x){this->emplace_back(std::move(x));}
+
+			/* Constructs an element in place at the end of self, using args as the arguments for its constructor.
+			 * Returns a reference to the new element. */
+			template<class... Args> inline T &emplace_back(Args&&... args);
+
+			/* Removes the first element of self. Shifts all elements. */
+			inline void pop_front(void){this->erase(this->begin(), this->begin() + 1);}
+
+			/* Removes the last element of self. The capacity is only reduced if the GrowthPolicy shrinks. */
+			inline void pop_back(void);
+
+			/* Requests the removal of unused capacity. Moves the elements back into the inline buffer if they fit. */
+			inline void shrink_to_fit(void)
+			{
+				if(!this->is_inline() && this->core.actualSize < this->core.actualCapacity) this->reallocate(this->core.actualSize);
+			}
+
+			/* Returns a reference to the last element. */
+			inline T &back(void){return this->objects[this->core.actualSize - 1];}
+			inline const T &back(void) const{return this->objects[this->core.actualSize - 1];}
+
+			/* Returns a reference to element n of self. If n is out of range the last element is returned. */
+			inline T &at(const size_t index){return this->objects[index < this->core.actualSize ? index : this->core.actualSize - 1];}
+			inline const T &at(const size_t index) const{return this->objects[index < this->core.actualSize ? index : this->core.actualSize - 1];}
+
+			/* Deletes all elements, the capacity is kept. */
+			inline void clear(void)
+			{
+				detail::destroy_range(this->begin(), this->end());
+				this->core.actualSize = 0;
+			}
+
+			/* Exchanges self with src. Heap arrays are swapped, inline elements are moved. */
+			inline void swap(iSmallVector<T, N, GrowthPolicy> &src);
+
+			/* Return actual core */
+			inline husk_t getCore(void) const{return this->core;}
+
+			/* Changes the Direction of all elements. */
+			inline void mirror(void){detail::reverse_range(this->begin(), this->end());}
+
+
+		// Operators
+
+			/* cast the iSmallVector obj in the basic T* datatype, the elements are contiguous */
+			inline operator T*() const{return this->objects;}
+
+			/* The assignment operator replaces the elements of self with a copy of the elements of rhs. */
+			inline iSmallVector<T, N, GrowthPolicy> &operator=(const iSmallVector<T, N, GrowthPolicy> &rhs)
+			{
+				if(this != &rhs)
+				{
+					this->clear();
+					this->reserve(rhs.size());
+					detail::uninitialized_copy_range(rhs.begin(), rhs.end(), this->objects);
+					this->core.actualSize = rhs.size();
+				}
+				return *this;
+			}
+
+			/* The move assignment takes over the heap array of rhs, or moves the inline elements. */
+			inline iSmallVector<T, N, GrowthPolicy> &operator=(iSmallVector<T, N, GrowthPolicy> &&rhs)
+			{
+				if(this != &rhs)
+				{
+					this->clear();
+					this->take(rhs);
+				}
+				return *this;
+			}
+
+			/* See push_back */
+			inline iSmallVector<T, N, GrowthPolicy> &operator+=(const T &rhs)
+			{
+				this->push_back(rhs);
+				return *this;
+			}
+
+			/* Returns a reference to element n of self. The index n must be between 0 and the size less one. */
+			inline T &operator[](const size_t index){return this->objects[index];}
+			inline const T &operator[](const size_t index) const{return this->objects[index];}
+
+
+		// Iterators
+			inline iterator begin(void){return this->objects;}
+			inline const_iterator begin(void) const{return this->objects;}
+			inline iterator end(void){return this->objects + this->core.actualSize;}
+			inline const_iterator end(void) const{return this->objects + this->core.actualSize;}
+			inline reverse_iterator rbegin(void){return reverse_iterator(this->objects + this->core.actualSize - 1);}
+			inline const_reverse_iterator rbegin(void) const{return const_reverse_iterator(this->objects + this->core.actualSize - 1);}
+			inline reverse_iterator rend(void){return reverse_iterator(this->objects - 1);}
+			inline const_reverse_iterator rend(void) const{return const_reverse_iterator(this->objects - 1);}
+	};
+
+	template<class T, size_t N, class GrowthPolicy> iSmallVector<T, N, GrowthPolicy>::~iSmallVector()
+	{
+		detail::destroy_range(this->begin(), this->end());
+		if(!this->is_inline()) detail::deallocate_raw(this->objects);
+	}
+
+	template<class T, size_t N, class GrowthPolicy> void iSmallVector<T, N, GrowthPolicy>::take(iSmallVector<T, N, GrowthPolicy> &rhs)
+	{
+		if(rhs.is_inline())
+		{	// the elements fit into any storage of self
+			detail::relocate_range(rhs.begin(), rhs.end(), this->objects);
+			this->core.actualSize = rhs.size();
+		}
+		else
+		{
+			if(!this->is_inline()) detail::deallocate_raw(this->objects);
+			this->core = rhs.core;
+			this->objects = rhs.objects;
+			rhs.objects = rhs.inline_array();
+			rhs.core.actualCapacity = N;
+		}
+		rhs.core.actualSize = 0;
+	}
+
+	template<class T, size_t N, class GrowthPolicy> bool iSmallVector<T, N, GrowthPolicy>::reallocate(const size_t newCapacity)
+	{
+		if(newCapacity <= N && this->is_inline()) return true;
+		T *newArray = newCapacity <= N ? this->inline_array() : detail::allocate_raw<T>(newCapacity);
+		if(newArray == null_ptr)
+		{
+            #ifdef GT_CERR_ACTIVE
+			std::cerr << "IN FUNCTION: template<class T, size_t N, class GrowthPolicy> bool iSmallVector<T, N, GrowthPolicy>::reallocate(const size_t newCapacity);" << std::endl;
+			std::cerr << "NOT ENOUGHT MEMORY." << std::endl;
+            #endif
+			return false;
+		}
+		detail::relocate_range(this->begin(), this->end(), newArray);
+		if(!this->is_inline()) detail::deallocate_raw(this->objects);
+		this->objects = newArray;
+		this->core.actualCapacity = newCapacity <= N ? N : newCapacity;
+		return true;
+	}
+
+	template<class T, size_t N, class GrowthPolicy> T *iSmallVector<T, N, GrowthPolicy>::make_gap(const size_t index, const size_t count)
+	{
+		const size_t required = this->core.actualSize + count;
+		if(required > this->core.actualCapacity)
+		{	// relocate both halves straight to their new place
+			const size_t newCapacity = this->grown_capacity(required);
+			T *newArray = detail::allocate_raw<T>(newCapacity);
+			if(newArray == null_ptr)
+			{
+                #ifdef GT_CERR_ACTIVE
+				std::cerr << "IN FUNCTION: template<class T, size_t N, class GrowthPolicy> T *iSmallVector<T, N, GrowthPolicy>::make_gap(const size_t index, const size_t count);" << std::endl;
+				std::cerr << "NOT ENOUGHT MEMORY." << std::endl;
+                #endif
+				throw std::bad_alloc();
+			}
+			detail::relocate_range(this->begin(), this->begin() + index, newArray);
+			detail::relocate_range(this->begin() + index, this->end(), newArray + index + count);
+			if(!this->is_inline()) detail::deallocate_raw(this->objects);
+			this->objects = newArray;
+			this->core.actualCapacity = newCapacity;
+			return this->objects + index;
+		}
+		detail::relocate_overlapping(this->begin() + index, this->end(), this->begin() + index + count);
+		return this->objects + index;
+	}
+
+	template<class T, size_t N, class GrowthPolicy> template<class... Args> T &iSmallVector<T, N, GrowthPolicy>::emplace_back(Args&&... args)
+	{
+		if(this->core.actualSize >= this->core.actualCapacity)
+		{
+			T item(std::forward<Args>(args)...); // args may refer into self
+			if(!this->reallocate(this->grown_capacity(this->core.actualSize + 1))) throw std::bad_alloc();
+			::new(static_cast<void *>(this->end())) T(std::move(item));
+		}
+		else ::new(static_cast<void *>(this->end())) T(std::forward<Args>(args)...);
+		return this->objects[this->core.actualSize++];
+	}
+
+	template<class T, size_t N, class GrowthPolicy> template<class... Args> typename iSmallVector<T, N, GrowthPolicy>::iterator
+		iSmallVector<T, N, GrowthPolicy>::emplace(const_iterator position, Args&&... args)
+	{
+		const size_t index = position - this->begin();
+		if(index >= this->size())
+			return &this->emplace_back(std::forward<Args>(args)...);
+
+		T item(std::forward<Args>(args)...); // args may refer into self
+		::new(static_cast<void *>(this->make_gap(index, 1))) T(std::move(item));
+		this->core.actualSize++;
+		return this->begin() + index;
+	}
+
+	template<class T, size_t N, class GrowthPolicy> typename iSmallVector<T, N, GrowthPolicy>::iterator
+		iSmallVector<T, N, GrowthPolicy>::insert(const_iterator position, const size_t n, const T &x)
+	{
+		const size_t index = position - this->begin();
+		if(n != 0)
+		{
+			const T item(x); // x may refer into self
+			std::uninitialized_fill_n(this->make_gap(index, n), n, item);
+			this->core.actualSize += n;
+		}
+		return this->begin() + index;
+	}
+
+	template<class T, size_t N, class GrowthPolicy> template<class InputIterator, class> typename iSmallVector<T, N, GrowthPolicy>::iterator
+		iSmallVector<T, N, GrowthPolicy>::insert(const_iterator position, InputIterator first, InputIterator last)
+	{	// append and rotate the new elements into place
+		const size_t index = position - this->begin(), oldSize = this->size();
+		for(; first != last; ++first) this->emplace_back(*first);
+		std::rotate(this->begin() + index, this->begin() + oldSize, this->end());
+		return this->begin() + index;
+	}
+
+	template<class T, size_t N, class GrowthPolicy> typename iSmallVector<T, N, GrowthPolicy>::iterator
+		iSmallVector<T, N, GrowthPolicy>::erase(const_iterator first, const_iterator last)
+	{
+		const size_t index = first - this->begin();
+		if(first < last)
+		{
+			detail::destroy_range(const_cast<iterator>(first), const_cast<iterator>(last));
+			detail::relocate_overlapping(const_cast<iterator>(last), this->end(), const_cast<iterator>(first));
+			this->core.actualSize -= last - first;
+
+			const size_t newCapacity = GrowthPolicy::shrink(this->core);
+			if(newCapacity < this->core.actualCapacity) this->reallocate(newCapacity);
+		}
+		return this->begin() + index;
+	}
+
+	template<class T, size_t N, class GrowthPolicy> void iSmallVector<T, N, GrowthPolicy>::resize(const size_t newSize)
+	{
+		if(newSize > this->core.actualCapacity)
+			this->reserve(this->grown_capacity(newSize));
+		if(newSize > this->core.actualSize)
+			std::uninitialized_fill(this->end(), this->begin() + newSize, T());
+		else
+			detail::destroy_range(this->begin() + newSize, this->end());
+		this->core.actualSize = newSize;
+	}
+
+	template<class T, size_t N, class GrowthPolicy> void iSmallVector<T, N, GrowthPolicy>::pop_back(void)
+	{
+		(this->objects + --this->core.actualSize)->~T();
+		const size_t newCapacity = GrowthPolicy::shrink(this->core);
+		if(newCapacity < this->core.actualCapacity) this->reallocate(newCapacity);
+	}
+
+	template<class T, size_t N, class GrowthPolicy> void iSmallVector<T, N, GrowthPolicy>::swap(iSmallVector<T, N, GrowthPolicy> &src)
+	{
+		if(this == &src) return;
+		if(!this->is_inline() && !src.is_inline())
+		{
+			std::swap(this->core, src.core);
+			std::swap(this->objects, src.objects);
+			return;
+		}
+		iSmallVector<T, N, GrowthPolicy> temp(std::move(src));
+		src.take(*this);
+		this->take(temp);
+	}
+} // end of namespace GT
+#endif // ISMALLVECTOR_H
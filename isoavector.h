@@ -0,0 +1,541 @@
+/*--------------------------------------------------------------------------------------------------*/
+/*      Autor: Georgios Terzoglou                                                                   */
+/*      Copyright (©) 2014 by Georgios Terzoglou                                                    */
+/*      Bug-reports and suggestions to georgios.terzoglou@googlemail.com                            */
+/*                                                                                                  */
+/*      GENERAL NOTE: I assume no liability for any damages with this header.                       */
+/*      Using this header at your own risk.                                                         */
+/*                                                                                                  */
+/*      Template class: iSoAVector<Fields...>                                                       */
+/*                                                                                                  */
+/*      A structure of arrays: records of several fields are kept as one contiguous column per      */
+/*      field, all columns share one size and capacity (one Husk, GT::default_growth). A scan of    */
+/*      one field only reads that column, and column<I>() hands it to the SIMD kernels as a plain   */
+/*      pointer. operator[] and the iterators return a proxy, a tuple of references to the fields   */
+/*      of one record, so std::sort and the other algorithms move whole records:                    */
+/*          GT::iSoAVector<uint32_t, float, std::string> rows;                                      */
+/*          rows.push_back(std::make_tuple(7u, 0.5f, std::string("seven")));                        */
+/*          rows.sort<1>();   // by the float column, the other columns are permuted alike          */
+/*--------------------------------------------------------------------------------------------------*/
+
+#ifndef ISOAVECTOR_H
+#define ISOAVECTOR_H
+
+#include "ivector.h"
+
+#include <tuple>
+
+namespace GT
+{
+	namespace detail
+	{
+		/* Compile time list of the column indices, make_soa_indices<N>::type is 0 ... N-1 */
+		template<size_t... I> struct soa_indices{};
+		template<size_t N, size_t... I> struct make_soa_indices: make_soa_indices<N - 1, N - 1, I...>{};
+		template<size_t... I> struct make_soa_indices<0, I...>{typedef soa_indices<I...> type;};
+
+		/* Evaluates a pack expansion from left to right: soa_expand{(expression, 0)...}; */
+		struct soa_expand{template<class... A> inline soa_expand(A&&...){}};
+
+		/* True if all B are true */
+		template<bool... B> struct soa_all: std::true_type{};
+		template<bool B, bool... R> struct soa_all<B, R...>: std::integral_constant<bool, B && soa_all<R...>::value>{};
+
+		/* The proxy of one record: references to its fields. Assignments write through to the
+		 * columns, swap exchanges the fields of two records. */
+		template<class... Fields> class soa_reference: public std::tuple<Fields &...>
+		{
+			private:
+				typedef std::tuple<Fields &...> base;
+
+				template<size_t... I> inline void swap_fields(soa_reference &src, soa_indices<I...>)
+				{
+					using std::swap;
+					soa_expand{(swap(std::get<I>(*this), std::get<I>(src)), 0)...};
+				}
+
+				template<size_t... I> inline void move_fields(soa_reference &src, soa_indices<I...>)
+				{
+					soa_expand{(std::get<I>(*this) = std::move(std::get<I>(src)), 0)...};
+				}
+
+			public:
+				typedef std::tuple<typename std::remove_const<Fields>::type...> value_type;
+
+				inline soa_reference(Fields &... fields): base(fields...){}
+				inline soa_reference(const soa_reference &src): base(src){}
+
+				/* Proxies of mutable records convert to proxies of const records */
+				template<class... Y> inline soa_reference(const soa_reference<Y...> &src): base(src){}
+
+				/* Proxies of const records also refer to the fields of a record value, so a
+				 * comparison that takes const_reference accepts both */
+				template<class... Y, class = typename std::enable_if<std::is_convertible<const std::tuple<Y...> &, base>::value>::type>
+				inline soa_reference(const std::tuple<Y...> &src): base(src){}
+
+				inline soa_reference &operator=(const soa_reference &src){base::operator=(static_cast<const base &>(src)); return *this;}
+				inline soa_reference &operator=(soa_reference &&src){this->move_fields(src, typename make_soa_indices<sizeof...(Fields)>::type()); return *this;}
+				inline soa_reference &operator=(const value_type &src){base::operator=(src); return *this;}
+				inline soa_reference &operator=(value_type &&src){base::operator=(std::move(src)); return *this;}
+
+				/* Copies the record */
+				inline operator value_type(void) const{return value_type(static_cast<const base &>(*this));}
+
+				friend inline void swap(soa_reference a, soa_reference b)
+				{
+					a.swap_fields(b, typename make_soa_indices<sizeof...(Fields)>::type());
+				}
+		};
+
+		/* Random access iterator of an iSoAVector: the container and an index. Reference is the
+		 * proxy type, there is no pointer type. */
+		template<class Container, class Reference> class soa_iterator
+		{
+			template<class, class> friend class soa_iterator;
+
+			private:
+				Container *owner;
+				size_t index;
+
+			public:
+				typedef std::random_access_iterator_tag iterator_category;
+				typedef typename Reference::value_type value_type;
+				typedef std::ptrdiff_t difference_type;
+				typedef void pointer;
+				typedef Reference reference;
+
+				inline soa_iterator(void): owner(null_ptr), index(0){}
+				inline soa_iterator(Container *owner, const size_t index): owner(owner), index(index){}
+
+				/* iterator to const_iterator */
+				template<class C, class R, class = typename std::enable_if<std::is_convertible<C *, Container *>::value>::type>
+				inline soa_iterator(const soa_iterator<C, R> &src): owner(src.owner), index(src.index){}
+
+				/* Returns the index of the record in the container */
+				inline size_t position(void) const{return this->index;}
+
+				inline reference operator*(void) const{return (*this->owner)[this->index];}
+				inline reference operator[](const difference_type n) const{return (*this->owner)[this->index + n];}
+
+				inline soa_iterator &operator++(void){++this->index; return *this;}
+				inline soa_iterator &operator--(void){--this->index; return *this;}
+				inline soa_iterator operator++(int){soa_iterator old(*this); ++this->index; return old;}
+				inline soa_iterator operator--(int){soa_iterator old(*this); --this->index; return old;}
+				inline soa_iterator &operator+=(const difference_type n){this->index += n; return *this;}
+				inline soa_iterator &operator-=(const difference_type n){this->index -= n; return *this;}
+				inline soa_iterator operator+(const difference_type n) const{return soa_iterator(this->owner, this->index + n);}
+				inline soa_iterator operator-(const difference_type n) const{return soa_iterator(this->owner, this->index - n);}
+				friend inline soa_iterator operator+(const difference_type n, const soa_iterator &it){return it + n;}
+
+				template<class C, class R> inline difference_type operator-(const soa_iterator<C, R> &it) const{return difference_type(this->index - it.index);}
+				template<class C, class R> inline bool operator==(const soa_iterator<C, R> &it) const{return this->index == it.index;}
+				template<class C, class R> inline bool operator!=(const soa_iterator<C, R> &it) const{return this->index != it.index;}
+				template<class C, class R> inline bool operator<(const soa_iterator<C, R> &it) const{return this->index < it.index;}
+				template<class C, class R> inline bool operator>(const soa_iterator<C, R> &it) const{return this->index > it.index;}
+				template<class C, class R> inline bool operator<=(const soa_iterator<C, R> &it) const{return this->index <= it.index;}
+				template<class C, class R> inline bool operator>=(const soa_iterator<C, R> &it) const{return this->index >= it.index;}
+		};
+	} // end of namespace detail
+
+	template<class... Fields> class iSoAVector
+	{
+		static_assert(sizeof...(Fields) != 0, "an iSoAVector needs at least one field");
+
+		public:
+		// Container types
+			typedef std::tuple<Fields...> value_type;
+			typedef detail::soa_reference<Fields...> reference;
+			typedef detail::soa_reference<const Fields...> const_reference;
+
+			/* The type of the field I */
+			template<size_t I> struct field{typedef typename std::tuple_element<I, value_type>::type type;};
+
+		// Iterator types
+			typedef detail::soa_iterator<iSoAVector<Fields...>, reference> iterator;
+			typedef detail::soa_iterator<const iSoAVector<Fields...>, const_reference> const_iterator;
+
+		private:
+		// Attributes
+			husk_t core;	// shared by all columns, see class Husk
+			std::tuple<Fields *...> columns;
+
+			typedef typename detail::make_soa_indices<sizeof...(Fields)>::type indices;
+
+		// Private methods
+			/* Moves the columns to arrays of newCapacity, throws std::bad_alloc if out of memory */
+			inline void reallocate(const size_t newCapacity);
+
+			template<size_t... I> inline void reallocate(const size_t newCapacity, detail::soa_indices<I...>);
+
+			/* Constructs the fields of the record at index from the tuple args, column I first. If
+			 * a field throws, the fields constructed before are destroyed again. */
+			template<size_t I, class Tuple> inline void construct(const size_t index, Tuple &&args, std::true_type);
+			template<size_t I, class Tuple> inline void construct(const size_t, Tuple &&, std::false_type){}
+
+			template<size_t I> struct has_field: std::integral_constant<bool, (I < sizeof...(Fields))>{};
+
+			template<size_t... I> inline reference record(const size_t index, detail::soa_indices<I...>)
+			{
+				return reference(std::get<I>(this->columns)[index]...);
+			}
+
+			template<size_t... I> inline const_reference record(const size_t index, detail::soa_indices<I...>) const
+			{
+				return const_reference(std::get<I>(this->columns)[index]...);
+			}
+
+			template<size_t... I> inline void destroy(const size_t index, detail::soa_indices<I...>)
+			{
+				detail::soa_expand{(std::get<I>(this->columns)[index].~Fields(), 0)...};
+			}
+
+			template<size_t... I> inline void null_columns(detail::soa_indices<I...>)
+			{
+				detail::soa_expand{(std::get<I>(this->columns) = null_ptr, 0)...};
+			}
+
+			/* Moves the record at source into the record at target (both constructed) */
+			template<size_t... I> inline void move_record(const size_t target, const size_t source, detail::soa_indices<I...>)
+			{
+				detail::soa_expand{(std::get<I>(this->columns)[target] = std::move(std::get<I>(this->columns)[source]), 0)...};
+			}
+
+			template<size_t... I> inline value_type take_record(const size_t index, detail::soa_indices<I...>)
+			{
+				return value_type(std::move(std::get<I>(this->columns)[index])...);
+			}
+
+			template<size_t... I> inline void put_record(const size_t index, value_type &src, detail::soa_indices<I...>)
+			{
+				detail::soa_expand{(std::get<I>(this->columns)[index] = std::move(std::get<I>(src)), 0)...};
+			}
+
+			/* Returns in order the indices of the records sorted by comp on the field I. Keys that are
+			 * trivially copyable are sorted next to their index, so the sort reads no other memory. */
+			template<size_t I, bool STABLE, class Compare> inline void order_by(iVector<size_t> &order, Compare &comp, std::true_type);
+			template<size_t I, bool STABLE, class Compare> inline void order_by(iVector<size_t> &order, Compare &comp, std::false_type);
+
+			template<class Iterator, class Compare> static inline void sort_range(Iterator first, Iterator last, Compare comp, std::true_type)
+			{
+				std::stable_sort(first, last, comp);
+			}
+
+			template<class Iterator, class Compare> static inline void sort_range(Iterator first, Iterator last, Compare comp, std::false_type)
+			{
+				std::sort(first, last, comp);
+			}
+
+			/* Permutes the records so that record k becomes the former record order[k]. Fields that
+			 * move without throwing are gathered column by column through one scratch array, the
+			 * others (or if the scratch array is out of memory) follow the cycles of order. */
+			inline void permute(iVector<size_t> &order, std::true_type);
+			inline void permute(iVector<size_t> &order, std::false_type);
+
+			template<size_t... I> inline void gather(const iVector<size_t> &order, void *scratch, detail::soa_indices<I...>)
+			{
+				detail::soa_expand{(this->gather_column<I>(order, scratch), 0)...};
+			}
+
+			template<size_t I> inline void gather_column(const iVector<size_t> &order, void *scratch)
+			{
+				typedef typename field<I>::type C;
+				C *column = std::get<I>(this->columns), *tmp = static_cast<C *>(scratch);
+				for(size_t k=0; k<order.size(); k++) ::new(static_cast<void *>(tmp + k)) C(std::move(column[order[k]]));
+				detail::destroy_range(column, column + order.size());
+				detail::relocate_range(tmp, tmp + order.size(), column);
+			}
+
+		public:
+
+		// Constructors
+
+			/* Creates an empty iSoAVector. No memory is allocated. */
+			inline iSoAVector(void): core(0, 0, 0, 0){this->null_columns(indices());}
+
+			inline iSoAVector(const iSoAVector<Fields...> &src): core(0, 0, 0, 0)
+			{
+				this->null_columns(indices());
+				try
+				{
+					this->reserve(src.size());
+					for(size_t i=0; i<src.size(); i++) this->push_back(src[i]);
+				}
+				catch(...)
+				{	// the destructor does not run
+					this->clear();
+					this->shrink_to_fit();
+					throw;
+				}
+			}
+
+			inline iSoAVector(iSoAVector<Fields...> &&src): core(src.core), columns(src.columns)
+			{
+				src.core.setHusk(0, 0, 0, 0);
+				src.null_columns(indices());
+			}
+
+		// Destructor
+			~iSoAVector(){this->clear(); this->shrink_to_fit();}
+
+		// Operators
+			inline iSoAVector<Fields...> &operator=(const iSoAVector<Fields...> &src)
+			{
+				if(this != &src)
+				{
+					iSoAVector<Fields...> copy(src);
+					this->swap(copy);
+				}
+				return *this;
+			}
+
+			inline iSoAVector<Fields...> &operator=(iSoAVector<Fields...> &&src)
+			{
+				this->swap(src);
+				return *this;
+			}
+
+			/* Returns the proxy of the record at index. No bounds check. */
+			inline reference operator[](const size_t index){return this->record(index, indices());}
+			inline const_reference operator[](const size_t index) const{return this->record(index, indices());}
+
+		// Methods
+			/* Returns the contiguous column of the field I, size() constructed elements. The pointer
+			 * is valid until the next reallocation, like the array of an iVector. */
+			template<size_t I> inline typename field<I>::type *column(void){return std::get<I>(this->columns);}
+			template<size_t I> inline const typename field<I>::type *column(void) const{return std::get<I>(this->columns);}
+
+			/* Appends a record */
+			inline void push_back(const value_type &x){this->emplace_back_tuple(x);}
+			inline void push_back(value_type &&x){this->emplace_back_tuple(std::move(x));}
+
+			/* Appends a record and constructs field I from args[I]. One argument per field. */
+			template<class... Args> inline void emplace_back(Args&&... args)
+			{
+				static_assert(sizeof...(Args) == sizeof...(Fields), "iSoAVector::emplace_back needs one argument per field");
+				this->emplace_back_tuple(std::forward_as_tuple(std::forward<Args>(args)...));
+			}
+
+			/* Appends a record and constructs field I from std::get<I>(args) */
+			template<class Tuple> inline void emplace_back_tuple(Tuple &&args);
+
+			/* Removes the last record */
+			inline void pop_back(void)
+			{
+				this->destroy(--this->core.actualSize, indices());
+				const size_t newCapacity = default_growth::shrink(this->core);
+				if(newCapacity < this->core.actualCapacity) this->reallocate(newCapacity);
+			}
+
+			inline reference front(void){return this->operator[](0);}
+			inline const_reference front(void) const{return this->operator[](0);}
+			inline reference back(void){return this->operator[](this->core.actualSize - 1);}
+			inline const_reference back(void) const{return this->operator[](this->core.actualSize - 1);}
+
+			/* Returns the number of records. */
+			inline size_t size(void) const{return this->core.actualSize;}
+
+			/* Returns true if the size is zero. */
+			inline bool empty(void) const{return this->core.actualSize == 0;}
+
+			/* Returns the number of records that fit into the columns without a reallocation. */
+			inline size_t capacity(void) const{return this->core.actualCapacity;}
+
+			/* Grows every column to newCapacity records. Does nothing if newCapacity <= capacity(). */
+			inline void reserve(const size_t newCapacity)
+			{
+				if(newCapacity > this->core.actualCapacity) this->reallocate(newCapacity);
+			}
+
+			/* Alters the number of records, appends value-initialized records or erases them off the end. */
+			inline void resize(const size_t newSize)
+			{
+				this->reserve(newSize);
+				while(this->core.actualSize > newSize) this->pop_back();
+				while(this->core.actualSize < newSize) this->emplace_back_tuple(value_type());
+			}
+
+			/* Destroys all records, keeps the columns. */
+			inline void clear(void)
+			{
+				while(this->core.actualSize != 0) this->destroy(--this->core.actualSize, indices());
+			}
+
+			/* Cuts the capacity of every column to the size */
+			inline void shrink_to_fit(void)
+			{
+				if(this->core.actualSize < this->core.actualCapacity) this->reallocate(this->core.actualSize);
+			}
+
+			/* Swaps the content of self and src in constant time. */
+			inline void swap(iSoAVector<Fields...> &src)
+			{
+				husk_t tmp(this->core);
+				this->core.setHusk(src.core.ascending, src.core.bearingsCount, src.core.actualSize, src.core.actualCapacity);
+				src.core.setHusk(tmp.ascending, tmp.bearingsCount, tmp.actualSize, tmp.actualCapacity);
+				std::swap(this->columns, src.columns);
+			}
+
+			/* Deletes the records in [first, last) and shifts the tail of every column in place.
+			 * Returns an iterator that points to the record behind the erased ones. */
+			inline iterator erase(const_iterator first, const_iterator last)
+			{
+				const size_t index = first.position(), pieces = last - first;
+				for(size_t i=index; i + pieces < this->core.actualSize; i++) this->move_record(i, i + pieces, indices());
+				for(size_t i=0; i<pieces; i++) this->destroy(--this->core.actualSize, indices());
+				return this->begin() + index;
+			}
+			inline iterator erase(const_iterator position){return this->erase(position, position + 1);}
+
+			/* Sorts the records by the field I (by comp on it). Sorts the key column with the record
+			 * indices, then permutes every column once in that order. */
+			template<size_t I> inline void sort(void){this->sort<I>(std::less<typename field<I>::type>());}
+			template<size_t I, class Compare> inline void sort(Compare comp);
+
+			/* Like sort<I>, but records with equal keys keep their order. */
+			template<size_t I> inline void stable_sort(void){this->stable_sort<I>(std::less<typename field<I>::type>());}
+			template<size_t I, class Compare> inline void stable_sort(Compare comp);
+
+			/* Searches the column of the field I like the iVector members, arithmetic fields with SIMD. */
+			template<size_t I> inline iterator find(const typename field<I>::type &x)
+			{
+				return this->begin() + detail::search<typename field<I>::type>::find(this->column<I>(), this->size(), x);
+			}
+			template<size_t I> inline const_iterator find(const typename field<I>::type &x) const
+			{
+				return this->begin() + detail::search<typename field<I>::type>::find(this->column<I>(), this->size(), x);
+			}
+			template<size_t I> inline size_t count(const typename field<I>::type &x) const
+			{
+				return detail::search<typename field<I>::type>::count(this->column<I>(), this->size(), x);
+			}
+			template<size_t I> inline typename field<I>::type sum(void) const
+			{
+				return detail::search<typename field<I>::type>::sum(this->column<I>(), this->size());
+			}
+
+		// Iterators
+			inline iterator begin(void){return iterator(this, 0);}
+			inline const_iterator begin(void) const{return const_iterator(this, 0);}
+			inline const_iterator cbegin(void) const{return const_iterator(this, 0);}
+			inline iterator end(void){return iterator(this, this->core.actualSize);}
+			inline const_iterator end(void) const{return const_iterator(this, this->core.actualSize);}
+			inline const_iterator cend(void) const{return const_iterator(this, this->core.actualSize);}
+	};
+
+	template<class... Fields> void iSoAVector<Fields...>::reallocate(const size_t newCapacity)
+	{
+		this->reallocate(newCapacity, indices());
+	}
+
+	template<class... Fields> template<size_t... I> void iSoAVector<Fields...>::reallocate(const size_t newCapacity, detail::soa_indices<I...>)
+	{
+		std::tuple<Fields *...> fresh;	// capacity 0 holds no memory
+		detail::soa_expand{(std::get<I>(fresh) = newCapacity == 0 || newCapacity > size_t(-1) / sizeof(Fields) ? null_ptr : detail::allocate_raw<Fields>(newCapacity), 0)...};
+		const bool missing[] = {std::get<I>(fresh) == null_ptr...};
+		if(newCapacity != 0 && std::find(missing, missing + sizeof...(Fields), true) != missing + sizeof...(Fields))
+		{	// all or nothing, the columns stay as they are
+			detail::soa_expand{(detail::deallocate_raw(std::get<I>(fresh)), 0)...};
+            #ifdef GT_CERR_ACTIVE
+			std::cerr << "IN FUNCTION: template<class... Fields> template<size_t... I> void iSoAVector<Fields...>::reallocate(const size_t newCapacity, detail::soa_indices<I...>);" << std::endl;
+			std::cerr << "NOT ENOUGHT MEMORY." << std::endl;
+            #endif
+			throw std::bad_alloc();
+		}
+		detail::soa_expand{(detail::relocate_range(std::get<I>(this->columns), std::get<I>(this->columns) + this->core.actualSize, std::get<I>(fresh)), 0)...};
+		detail::soa_expand{(detail::deallocate_raw(std::get<I>(this->columns)), 0)...};
+		this->columns = fresh;
+		this->core.actualCapacity = newCapacity;
+	}
+
+	template<class... Fields> template<size_t I, class Tuple> void iSoAVector<Fields...>::construct(const size_t index, Tuple &&args, std::true_type)
+	{
+		typedef typename field<I>::type C;
+		C *p = std::get<I>(this->columns) + index;
+		::new(static_cast<void *>(p)) C(std::get<I>(std::forward<Tuple>(args)));
+		try
+		{
+			this->construct<I + 1>(index, std::forward<Tuple>(args), has_field<I + 1>());
+		}
+		catch(...)
+		{
+			p->~C();
+			throw;
+		}
+	}
+
+	template<class... Fields> template<class Tuple> void iSoAVector<Fields...>::emplace_back_tuple(Tuple &&args)
+	{
+		if(this->core.actualSize == this->core.actualCapacity)
+		{	// construct the record first, args may refer into the old columns
+			value_type item(std::forward<Tuple>(args));
+			this->reallocate(this->core.actualCapacity == 0 ?
+					default_growth::initial(this->core, this->core.actualSize + 1) : default_growth::grow(this->core, this->core.actualSize + 1));
+			this->construct<0>(this->core.actualSize, std::move(item), std::true_type());
+		}
+		else this->construct<0>(this->core.actualSize, std::forward<Tuple>(args), std::true_type());
+		this->core.actualSize++;
+	}
+
+	template<class... Fields> template<size_t I, bool STABLE, class Compare>
+	void iSoAVector<Fields...>::order_by(iVector<size_t> &order, Compare &comp, std::true_type)
+	{
+		typedef typename field<I>::type K;
+		const K *key = this->column<I>();
+		iVector<std::pair<K, size_t> > keyed(this->size());
+		for(size_t i=0; i<this->size(); i++) keyed.push_back(std::pair<K, size_t>(key[i], i));
+		sort_range(keyed.begin(), keyed.end(), [&](const std::pair<K, size_t> &a, const std::pair<K, size_t> &b){return comp(a.first, b.first);},
+				   std::integral_constant<bool, STABLE>());
+		order.reserve(this->size());
+		for(size_t i=0; i<keyed.size(); i++) order.push_back(keyed[i].second);
+	}
+
+	template<class... Fields> template<size_t I, bool STABLE, class Compare>
+	void iSoAVector<Fields...>::order_by(iVector<size_t> &order, Compare &comp, std::false_type)
+	{
+		const typename field<I>::type *key = this->column<I>();
+		order.reserve(this->size());
+		for(size_t i=0; i<this->size(); i++) order.push_back(i);
+		sort_range(order.begin(), order.end(), [&](const size_t a, const size_t b){return comp(key[a], key[b]);}, std::integral_constant<bool, STABLE>());
+	}
+
+	template<class... Fields> void iSoAVector<Fields...>::permute(iVector<size_t> &order, std::true_type)
+	{
+		const size_t sizes[] = {sizeof(Fields)...};
+		void *scratch = std::malloc(*std::max_element(sizes, sizes + sizeof...(Fields)) * (order.size() != 0 ? order.size() : 1));
+		if(scratch == null_ptr) return this->permute(order, std::false_type());
+		this->gather(order, scratch, indices());
+		std::free(scratch);
+	}
+
+	template<class... Fields> void iSoAVector<Fields...>::permute(iVector<size_t> &order, std::false_type)
+	{
+		for(size_t i=0; i<order.size(); i++)
+		{
+			if(order[i] == i) continue;
+			value_type held(this->take_record(i, indices()));
+			size_t j = i;
+			for(size_t k = order[j]; k != i; j = k, k = order[j])
+			{
+				this->move_record(j, k, indices());
+				order[j] = j;
+			}
+			this->put_record(j, held, indices());
+			order[j] = j;
+		}
+	}
+
+	template<class... Fields> template<size_t I, class Compare> void iSoAVector<Fields...>::sort(Compare comp)
+	{
+		iVector<size_t> order;
+		this->order_by<I, false>(order, comp, std::is_trivially_copyable<typename field<I>::type>());
+		this->permute(order, detail::soa_all<std::is_nothrow_move_constructible<Fields>::value...>());
+	}
+
+	template<class... Fields> template<size_t I, class Compare> void iSoAVector<Fields...>::stable_sort(Compare comp)
+	{
+		iVector<size_t> order;
+		this->order_by<I, true>(order, comp, std::is_trivially_copyable<typename field<I>::type>());
+		this->permute(order, detail::soa_all<std::is_nothrow_move_constructible<Fields>::value...>());
+	}
+} // end of namespace GT
+#endif // ISOAVECTOR_H
@@ -0,0 +1,280 @@
+/*--------------------------------------------------------------------------------------------------*/
+/*      Autor: Georgios Terzoglou                                                                   */
+/*      Copyright (©) 2014 by Georgios Terzoglou                                                    */
+/*      Bug-reports and suggestions to georgios.terzoglou@googlemail.com                            */
+/*                                                                                                  */
+/*      GENERAL NOTE: I assume no liability for any damages with this header.                       */
+/*      Using this header at your own risk.                                                         */
+/*                                                                                                  */
+/*      Template class: iStaticVector<T, N, OverflowPolicy>                                         */
+/*                                                                                                  */
+/*      A vector with room for N elements inside the object and the iVector API. It never           */
+/*      allocates and never grows. With C++20 every member is constexpr, so tables can be           */
+/*      built at compile time; an iStaticVector of trivially copyable T is trivially copyable       */
+/*      itself. The OverflowPolicy decides what a push_back into a full vector does:                */
+/*          GT::checked_overflow     reports it and throws std::bad_alloc (the default)             */
+/*          GT::unchecked_overflow   no check at all, overflowing is undefined behavior             */
+/*--------------------------------------------------------------------------------------------------*/
+
+#ifndef ISTATICVECTOR_H
+#define ISTATICVECTOR_H
+
+#include "ivector.h"
+
+#include <initializer_list>
+
+#if __cplusplus >= 202002L
+#define GT_CONSTEXPR20 constexpr // std::construct_at, constexpr destructors and algorithms
+#else
+#define GT_CONSTEXPR20
+#endif
+
+namespace GT
+{
+	/* Overflow policies of iStaticVector */
+	struct checked_overflow{static const bool checked = true;};
+	struct unchecked_overflow{static const bool checked = false;};
+
+	namespace detail
+	{
+		/* Starts the lifetime of a T at p, constexpr with C++20 */
+		template<class T, class... Args> GT_CONSTEXPR20 inline void construct_static(T *p, Args&&... args)
+		{
+        #if __cplusplus >= 202002L
+			std::construct_at(p, std::forward<Args>(args)...);
+        #else
+			::new(static_cast<void *>(p)) T(std::forward<Args>(args)...);
+        #endif
+		}
+
+		/* Ends the lifetime of the T at p. A function on its own, because GCC drops the side effects
+		 * of the object expression of a pseudo destructor call (T = int) in constant evaluation.
+		 * A trivial destructor is not called, so the element stays initialized for a constexpr variable. */
+		template<class T> GT_CONSTEXPR20 inline void destroy_static(T *p)
+		{
+        #if __cplusplus >= 202002L
+			if constexpr(!std::is_trivially_destructible<T>::value) p->~T();
+        #else
+			p->~T();
+        #endif
+		}
+
+		/* Room for N elements of which the first count live. The union leaves the elements
+		 * unconstructed. Trivially copyable T keeps the implicit (trivial) copy and destructor.
+		 * A constexpr variable needs all N elements initialized, so in constant evaluation the
+		 * storage of a default constructible T is value-initialized; at run time it is not. */
+		template<class T, size_t N, bool = std::is_trivially_copyable<T>::value> struct static_storage
+		{
+			union{T data[N];};
+			size_t count;
+
+			GT_CONSTEXPR20 inline static_storage(void): count(0)
+			{
+            #if __cplusplus >= 202002L
+				if constexpr(std::is_default_constructible<T>::value)
+					if(std::is_constant_evaluated())
+						for(size_t i=0; i<N; i++) std::construct_at(this->data + i);
+            #endif
+			}
+		};
+
+		template<class T, size_t N> struct static_storage<T, N, false>
+		{
+			union{T data[N];};
+			size_t count;
+
+			GT_CONSTEXPR20 inline static_storage(void): count(0){}
+
+			GT_CONSTEXPR20 inline static_storage(const static_storage &src): count(0)
+			{
+				for(; this->count < src.count; this->count++) construct_static(this->data + this->count, src.data[this->count]);
+			}
+
+			GT_CONSTEXPR20 inline static_storage(static_storage &&src): count(0)
+			{
+				for(; this->count < src.count; this->count++) construct_static(this->data + this->count, std::move(src.data[this->count]));
+			}
+
+			GT_CONSTEXPR20 inline static_storage &operator=(const static_storage &src)
+			{
+				if(this != &src) this->assign(src.data, src.count);
+				return *this;
+			}
+
+			GT_CONSTEXPR20 inline static_storage &operator=(static_storage &&src)
+			{
+				if(this != &src) this->assign(std::make_move_iterator(src.data), src.count);
+				return *this;
+			}
+
+			GT_CONSTEXPR20 inline ~static_storage(){while(this->count != 0) destroy_static(this->data + --this->count);}
+
+			/* Assigns the n elements from first: overwrites the live ones, constructs or destroys the rest */
+			template<class Iterator> GT_CONSTEXPR20 inline void assign(Iterator first, const size_t n)
+			{
+				size_t i = 0;
+				for(; i < n && i < this->count; i++, ++first) this->data[i] = *first;
+				for(; i < n; i++, ++first, this->count++) construct_static(this->data + i, *first);
+				while(this->count > n) destroy_static(this->data + --this->count);
+			}
+		};
+	} // end of namespace detail
+
+	template<class T, size_t N, class OverflowPolicy = checked_overflow> class iStaticVector
+	{
+		static_assert(N > 0, "iStaticVector needs room for at least one element");
+
+		private:
+		// Attributes
+			detail::static_storage<T, N> store;
+
+		// Private methods
+			/* Reports a full vector if the OverflowPolicy checks */
+			GT_CONSTEXPR20 inline void check_room(const size_t n, const char *function) const
+			{
+				if(OverflowPolicy::checked && N - this->store.count < n)
+				{
+                    #ifdef GT_CERR_ACTIVE
+					std::cerr << "IN FUNCTION: " << function << std::endl;
+					std::cerr << "NOT ENOUGHT MEMORY." << std::endl;
+                    #else
+					GT_UNUSED(function);
+                    #endif
+					throw std::bad_alloc();
+				}
+			}
+
+		public:
+
+		// Iterator types
+			typedef T *iterator;
+			typedef const T *const_iterator;
+
+		// Container types
+			typedef T value_type;
+
+		// Constructors
+
+			/* Creates an empty iStaticVector */
+			GT_CONSTEXPR20 inline iStaticVector(void){}
+
+			/* Creates an iStaticVector of n copies of src */
+			GT_CONSTEXPR20 inline explicit iStaticVector(const T &src, const size_t n = 1)
+			{
+				this->check_room(n, "template<class T, size_t N, class OverflowPolicy> iStaticVector<T, N, OverflowPolicy>::iStaticVector(const T &src, const size_t n);");
+				for(; this->store.count < n; this->store.count++) detail::construct_static(this->store.data + this->store.count, src);
+			}
+
+			/* Creates an iStaticVector of the elements of list */
+			GT_CONSTEXPR20 inline iStaticVector(std::initializer_list<T> list)
+			{
+				this->check_room(list.size(), "template<class T, size_t N, class OverflowPolicy> iStaticVector<T, N, OverflowPolicy>::iStaticVector(std::initializer_list<T> list);");
+				for(const T *p = list.begin(); p != list.end(); ++p, this->store.count++) detail::construct_static(this->store.data + this->store.count, *p);
+			}
+
+		// Operators
+			GT_CONSTEXPR20 inline T &operator[](const size_t index){return this->store.data[index];}
+			GT_CONSTEXPR20 inline const T &operator[](const size_t index) const{return this->store.data[index];}
+
+			/* The elements as an array, like iVector */
+			GT_CONSTEXPR20 inline operator T *(void){return this->store.data;}
+			GT_CONSTEXPR20 inline operator const T *(void) const{return this->store.data;}
+
+		// Methods
+			/* Appends x. A full vector is handled by the OverflowPolicy. */
+			GT_CONSTEXPR20 inline void push_back(const T &x){this->emplace_back(x);}
+			GT_CONSTEXPR20 inline void push_back(T &&x){this->emplace_back(std::move(x));}
+
+			/* Constructs an element with args at the end and returns it. */
+			template<class... Args> GT_CONSTEXPR20 inline T &emplace_back(Args&&... args)
+			{
+				this->check_room(1, "template<class T, size_t N, class OverflowPolicy> template<class... Args> T &iStaticVector<T, N, OverflowPolicy>::emplace_back(Args&&... args);");
+				detail::construct_static(this->store.data + this->store.count, std::forward<Args>(args)...);
+				return this->store.data[this->store.count++];
+			}
+
+			/* Removes the last element */
+			GT_CONSTEXPR20 inline void pop_back(void){detail::destroy_static(this->store.data + --this->store.count);}
+
+			/* Inserts x in front of position and shifts the tail by one. Returns the new element. */
+			GT_CONSTEXPR20 inline iterator insert(const_iterator position, const T &x)
+			{
+				this->check_room(1, "template<class T, size_t N, class OverflowPolicy> T *iStaticVector<T, N, OverflowPolicy>::insert(const T *position, const T &x);");
+				const size_t index = position - this->begin();
+				T item(x);	// x may be an element of self
+				if(index == this->store.count) detail::construct_static(this->end(), std::move(item));
+				else
+				{
+					detail::construct_static(this->end(), std::move(this->back()));
+					std::move_backward(this->begin() + index, this->end() - 1, this->end());
+					this->store.data[index] = std::move(item);
+				}
+				this->store.count++;
+				return this->begin() + index;
+			}
+
+			/* Deletes the elements in [first, last) and shifts the tail in place.
+			 * Returns an iterator that points to the element behind the erased ones. */
+			GT_CONSTEXPR20 inline iterator erase(const_iterator first, const_iterator last)
+			{
+				const size_t index = first - this->begin(), pieces = last - first;
+				std::move(this->begin() + index + pieces, this->end(), this->begin() + index);
+				for(size_t i=0; i<pieces; i++) this->pop_back();
+				return this->begin() + index;
+			}
+			GT_CONSTEXPR20 inline iterator erase(const_iterator position){return this->erase(position, position + 1);}
+
+			/* Returns the element at index. Out of range it reports the index and returns the last
+			 * element like iVector::at. */
+			GT_CONSTEXPR20 inline T &at(const size_t index)
+			{
+				if(index >= this->store.count && this->store.count != 0)
+				{
+                    #ifdef GT_CERR_ACTIVE
+					std::cerr << "IN FUNCTION: template<class T, size_t N, class OverflowPolicy> T &iStaticVector<T, N, OverflowPolicy>::at(size_t index);" << std::endl;
+					std::cerr << "Caution: The largest possible index of the \"at()\" function is " << this->store.count - 1
+							  << " and you have entered the number " << index << " !!!" << std::endl;
+                    #endif
+					return this->back();
+				}
+				return this->store.data[index];
+			}
+			GT_CONSTEXPR20 inline const T &at(const size_t index) const{return const_cast<iStaticVector<T, N, OverflowPolicy> *>(this)->at(index);}
+
+			GT_CONSTEXPR20 inline T &front(void){return this->store.data[0];}
+			GT_CONSTEXPR20 inline const T &front(void) const{return this->store.data[0];}
+			GT_CONSTEXPR20 inline T &back(void){return this->store.data[this->store.count - 1];}
+			GT_CONSTEXPR20 inline const T &back(void) const{return this->store.data[this->store.count - 1];}
+
+			/* Alters the size, appends value-initialized elements or erases them off the end. */
+			GT_CONSTEXPR20 inline void resize(const size_t newSize)
+			{
+				if(newSize > this->store.count) this->check_room(newSize - this->store.count, "template<class T, size_t N, class OverflowPolicy> void iStaticVector<T, N, OverflowPolicy>::resize(const size_t newSize);");
+				while(this->store.count > newSize) this->pop_back();
+				while(this->store.count < newSize) this->emplace_back();
+			}
+
+			/* Destroys all elements */
+			GT_CONSTEXPR20 inline void clear(void){while(this->store.count != 0) this->pop_back();}
+
+			/* Returns the element equal to x, end() if there is none */
+			GT_CONSTEXPR20 inline iterator find(const T &x){return std::find(this->begin(), this->end(), x);}
+			GT_CONSTEXPR20 inline const_iterator find(const T &x) const{return std::find(this->begin(), this->end(), x);}
+			GT_CONSTEXPR20 inline bool contains(const T &x) const{return this->find(x) != this->end();}
+
+			GT_CONSTEXPR20 inline size_t size(void) const{return this->store.count;}
+			GT_CONSTEXPR20 inline bool empty(void) const{return this->store.count == 0;}
+			GT_CONSTEXPR20 inline bool full(void) const{return this->store.count == N;}
+			static constexpr size_t capacity(void){return N;}
+			static constexpr size_t max_size(void){return N;}
+
+		// Iterators
+			GT_CONSTEXPR20 inline iterator begin(void){return this->store.data;}
+			GT_CONSTEXPR20 inline const_iterator begin(void) const{return this->store.data;}
+			GT_CONSTEXPR20 inline const_iterator cbegin(void) const{return this->store.data;}
+			GT_CONSTEXPR20 inline iterator end(void){return this->store.data + this->store.count;}
+			GT_CONSTEXPR20 inline const_iterator end(void) const{return this->store.data + this->store.count;}
+			GT_CONSTEXPR20 inline const_iterator cend(void) const{return this->store.data + this->store.count;}
+	};
+} // end of namespace GT
+#endif // ISTATICVECTOR_H
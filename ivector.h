@@ -9,11 +9,11 @@
 /*      Using this header at your own risk.                                                         */
 /*                                                                                                  */
 /*                                                                                                  */
-/*      FROM THE LINE 147 TO THE END OF THIS HEADER MODIFICATIONS ARE PROHIBITED !!                 */
+/*      FROM THE LINE 122 TO THE END OF THIS HEADER MODIFICATIONS ARE PROHIBITED !!                 */
 /*                                                                                                  */
 /*                                                                                                  */
 /*                                                                                                  */
-/*      Template class: iVector<T>                                                                  */
+/*      Template class: iVector<T, GrowthPolicy, Allocator>                                         */
 /*                                                                                                  */
 /*                                                                                                  */
 /*      Version:       1.2.8.0473                                                                   */
@@ -48,17 +48,19 @@
 /*      references than lists and forward_lists.                                                    */
 /*--------------------------------------------------------------------------------------------------*/
 
-/** iVector use different settings for memory management if desired. **/
+/** iVector use different strategies for memory management if desired. **/
 
-/** INFORMATION: For personalized memory Settings looking this lines 122  -  141
+/** INFORMATION: The memory management is chosen per container by the second template
+	parameter GrowthPolicy. [looking on: Growth policies]
 
-  * NOTE: It is not recommended to modify the settings. They could thus degrade the
-		  speed greatly. Keep in mind that by doing these settings apply to all objects!
+  * NOTE: iVector<T> uses GT::default_growth (see: Dynamic overflow management).
+		  Different containers in one program can use different policies.
 
-	* switch for memory management system:        123  -  124
-	* General Settings:                           126  -  127
-	* Constant overflow management settings:      129  -  133
-	* Dynamic overflow management:                135  -  140
+	* iVector<int>                                        -> GT::default_growth
+	* iVector<int, GT::geometric_growth<> >               -> multiply the capacity by 3/2
+	* iVector<int, GT::fixed_step_growth<5000> >          -> Constant overflow management
+	* iVector<int, GT::std_vector_growth>                 -> Authentic std::vector settings
+	* iVector<int, GT::hysteresis_shrink<GT::geometric_growth<> > > -> shrinks on pop_back
 */
 
 /* Important informations about the different iterator types:
@@ -78,68 +80,46 @@
  * returned by member functions rbegin() and rend() of the iVector<T> container.
 */
 
-/** Constant overflow management
+/** Constant overflow management: GT::fixed_step_growth<STEP, FIRST_RESERVE_AMOUNT>
 
 	* explanation the constant concepts:
 	-----------------------------------------------------------
-	* MINIMAL_OVERFLOW           = minimum space required above
-	* MAXIMAL_OVERFLOW           = maximum space required above
-	* REMOVE_IF_IT_IS_LARGER     = limit,delete too much memory
+	* STEP                       = constant space added above
+	* FIRST_RESERVE_AMOUNT       = capacity of the first allocation
+*/
 
- * Activate the constant mode: Ensure the line 124 is commented out!
- * commented out: "#define GT_ACTIVATE_AUTOMATIC_MODE_FOR_OVERFLOW"
- * looking on line 124
+/** Empty iVectors:
+	* A default constructed iVector holds no memory. The first insertion allocates the
+	* capacity the policy chooses (FIRST_RESERVE_AMOUNT), clear() keeps the capacity.
 */
 
-/** Dynamic overflow management
+/** Dynamic overflow management: GT::dynamic_growth<FIRST_RESERVE_AMOUNT, AUTO_MAXIMAL_OVERFLOW,
+									ADJUST_BASE_NUMBER, INITIAL_BASE_VALUE>
 
-	* Optimized iVector settings:
-	* You can used the GT::iVector<T> in the same
-	* memory allocation settings as std::vector<T>. (See: Authentic std::vector settings)
-	* In the optimized GT::iVector<T> settings are used greater memory steps
-	* then std::vector<T> and a greater startvelue of allocated memory. (More speed)
-	* If you know the maximum size of your GT::iVector<T> use this startvalue for maximum speed.
+	* The added space is ADJUST_BASE_NUMBER << n, where n starts at INITIAL_BASE_VALUE and
+	* increases with every reallocation until AUTO_MAXIMAL_OVERFLOW. The Husk fields
+	* ascending and bearingsCount hold n. (GT::default_growth == GT::dynamic_growth<>)
 
-	* Authentic std::vector settings:		 * Optimized GT::iVector settings:
+	* GT::std_vector_growth:				 * GT::dynamic_growth<> settings:
 	---------------------------------		 ---------------------------------
 	* FIRST_RESERVE_AMOUNT        = 0              * FIRST_RESERVE_AMOUNT        = 16
-	* AUTO_MINIMAL_OVERFLOW       = 0              * AUTO_MINIMAL_OVERFLOW       = 0
-	* AUTO_MAXIMAL_OVERFLOW       = 26             * AUTO_MAXIMAL_OVERFLOW       = 26
-	* ADJUST_BASE_NUMBER          = 1              * ADJUST_BASE_NUMBER          = 1
-	* INITIAL_BASE_VALUE          = 0              * INITIAL_BASE_VALUE          = 4
+	* capacity is doubled                          * AUTO_MAXIMAL_OVERFLOW       = 26
+	                                               * ADJUST_BASE_NUMBER          = 1
+	                                               * INITIAL_BASE_VALUE          = 4
 	 ---------------------------------		 ---------------------------------
 
  * The dynamic mode is recommended!
+*/
 
- * Activate the dynamic mode: Ensure the line 124 is commented in!
- * commented in: "#define  GT_ACTIVATE_AUTOMATIC_MODE_FOR_OVERFLOW"
- * looking on line 124
+/** Shrinking:
+	* No policy gives memory back when elements are removed, pop_back is O(1).
+	* Use shrink_to_fit() or GT::hysteresis_shrink<GrowthPolicy, DIVISOR>, which shrinks
+	* to twice the size once less than 1/DIVISOR of the capacity is used.
 */
 
 #ifndef IVECTOR_H
 #define IVECTOR_H
 
-// ------------------------------------MEMORY-SETTINGS-BEGIN------------------------------------ //
-/* switch for memory management system. [check out the line at 81 or 117] */
-#define GT_ACTIVATE_AUTOMATIC_MODE_FOR_OVERFLOW      // Switch the Memory management mode
-
-/* startup memory settings [Associated for constant and dynamic mode.] */
-#define STARTUP_MEMORY_ALLOCATION_BLOCKS          16 // FIRST_RESERVE_AMOUNT
-
-/* Constant overflow management */
-// using if: GT_ACTIVATE_AUTOMATIC_MODE_FOR_OVERFLOW == not defined
-#define MINIMAL_OVERFLOW_FOR_CONSTANT_MODE         1 // MINIMAL_OVERFLOW
-#define MAXIMAL_OVERFLOW_FOR_CONSTANT_MODE      5000 // MAXIMAL_OVERFLOW
-#define REMOVE_IF_IT_IS_LARGER_FOR_CONSTANT_MODE  50 // REMOVE_IF_IT_IS_LARGER
-
-/* Dynamic overflow management */
-// using if: GT_ACTIVATE_AUTOMATIC_MODE_FOR_OVERFLOW == are defined
-#define AUTO_MINIMAL_OVERFLOW_FOR_DYNAMIC_MODE     0 // AUTO_MINIMAL_OVERFLOW
-#define AUTO_MAXIMAL_OVERFLOW_FOR_DYNAMIC_MODE    26 // AUTO_MAXIMAL_OVERFLOW
-#define ADJUST_BASE_NUMBER_FOR_DYNAMIC_MODE        1 // ADJUST_BASE_NUMBER
-#define INITIAL_BASE_VALUE_FOR_DYNAMIC_MODE        4 // INITIAL_BASE_VALUE
-// -------------------------------------MEMORY-SETTINGS-END------------------------------------- //
-
 // -------------------------------------ERROR-SETTINGS-BEGIN------------------------------------ //
 #define GT_CERR_ACTIVE // Commend out to deactivate the cerr calls!
 // -------------------------------------ERROR-SETTINGS-END-------------------------------------- //
@@ -149,10 +129,32 @@
 // - - - - - - - - - - - - - - FROM THIS LINE CHANGES ARE PROHIBITED - - - - - - - - - - - - - - //
 // --------------------------------------------------------------------------------------------- //
 
+#include <new>
+#include <memory>
+#include <utility>
+#include <iterator>
+#include <type_traits>
 #include <cstddef>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <algorithm>
+#include <string>
+#include <cstdint>
+#include <limits>
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#define GT_HAS_UNISTD
+#endif
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) && !defined(GT_NO_SIMD)
+#define GT_HAS_SIMD // SSE2/AVX2/AVX-512 search kernels, chosen at runtime. Define GT_NO_SIMD for plain loops.
+#endif
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#define GT_HAS_MEMORY_RESOURCE
+#endif
+#endif
 
 /** Memory allocation:
  *  Implementation of GT::ALLOCATE to substitute the "new" operator.
@@ -346,6 +348,99 @@ namespace GT
 		return *this;
 	}
 
+	/* Growth policies:
+		A growth policy decides the capacity of an iVector. It is a class with three static methods:
+			initial(core, required) - prepares the policy state in core, returns the first capacity
+			grow(core, required)    - returns a capacity >= required if the array is full
+			shrink(core)            - returns the capacity after elements were removed
+									  (core.actualCapacity keeps the array)
+		The state of a policy lives in the Husk fields ascending and bearingsCount.
+	*/
+
+	/* Dynamic overflow management: adds ADJUST_BASE_NUMBER << ascending */
+	template<size_t FIRST_RESERVE_AMOUNT = 16, size_t AUTO_MAXIMAL_OVERFLOW = 26,
+			 size_t ADJUST_BASE_NUMBER = 1, size_t INITIAL_BASE_VALUE = 4> struct dynamic_growth
+	{
+		static inline size_t initial(husk_t &core, const size_t required)
+		{
+			core.ascending = INITIAL_BASE_VALUE; core.bearingsCount = 0;
+			return std::max(required, FIRST_RESERVE_AMOUNT < 1 ? size_t(1) : FIRST_RESERVE_AMOUNT);
+		}
+
+		static inline size_t grow(husk_t &core, const size_t required)
+		{
+			if(core.bearingsCount < AUTO_MAXIMAL_OVERFLOW) core.bearingsCount = core.ascending++;
+			return std::max(required, core.actualCapacity + (ADJUST_BASE_NUMBER << core.bearingsCount));
+		}
+
+		static inline size_t shrink(husk_t &core){return core.actualCapacity;}
+	}; typedef GT::dynamic_growth<> default_growth;
+
+	/* Constant overflow management: adds STEP elements */
+	template<size_t STEP = 5000, size_t FIRST_RESERVE_AMOUNT = 16> struct fixed_step_growth
+	{
+		static inline size_t initial(husk_t &core, const size_t required)
+		{
+			GT_UNUSED(core);
+			return std::max(required, FIRST_RESERVE_AMOUNT < 1 ? size_t(1) : FIRST_RESERVE_AMOUNT);
+		}
+
+		static inline size_t grow(husk_t &core, const size_t required)
+		{
+			return std::max(required, core.actualCapacity + (STEP < 1 ? size_t(1) : STEP));
+		}
+
+		static inline size_t shrink(husk_t &core){return core.actualCapacity;}
+	};
+
+	/* Multiplies the capacity by NUMERATOR / DENOMINATOR */
+	template<size_t NUMERATOR = 3, size_t DENOMINATOR = 2, size_t FIRST_RESERVE_AMOUNT = 16> struct geometric_growth
+	{
+		static inline size_t initial(husk_t &core, const size_t required)
+		{
+			GT_UNUSED(core);
+			return std::max(required, FIRST_RESERVE_AMOUNT < 1 ? size_t(1) : FIRST_RESERVE_AMOUNT);
+		}
+
+		static inline size_t grow(husk_t &core, const size_t required)
+		{
+			const size_t grown = core.actualCapacity / DENOMINATOR * NUMERATOR
+							   + core.actualCapacity % DENOMINATOR * NUMERATOR / DENOMINATOR;
+			return std::max(required, grown > core.actualCapacity ? grown : core.actualCapacity + 1);
+		}
+
+		static inline size_t shrink(husk_t &core){return core.actualCapacity;}
+	};
+
+	/* Authentic std::vector settings: allocates exactly the requested size first, then doubles */
+	struct std_vector_growth
+	{
+		static inline size_t initial(husk_t &core, const size_t required)
+		{
+			GT_UNUSED(core);
+			return required;
+		}
+
+		static inline size_t grow(husk_t &core, const size_t required)
+		{
+			return std::max(required, core.actualCapacity != 0 ? core.actualCapacity * 2 : size_t(1));
+		}
+
+		static inline size_t shrink(husk_t &core){return core.actualCapacity;}
+	};
+
+	/* Adds shrinking to a GrowthPolicy. Once less than 1/DIVISOR of the capacity is used,
+	   the capacity is cut to twice the size. Growth and shrink are a factor DIVISOR / 2 apart,
+	   so push_back and pop_back around one size never reallocate alternately. */
+	template<class GrowthPolicy, size_t DIVISOR = 4> struct hysteresis_shrink: GrowthPolicy
+	{
+		static inline size_t shrink(husk_t &core)
+		{
+			if(core.actualSize * (DIVISOR < 3 ? 3 : DIVISOR) >= core.actualCapacity) return core.actualCapacity;
+			return core.actualSize * 2;
+		}
+	};
+
 	#if !defined(GTHEADER_H)
 	/* to check whether a class is derived from each other class. */
 	template<class Base, class Derived> class is
@@ -356,435 +451,2300 @@ namespace GT
 
 			static yes test_derived(Base);
 			static no test_derived(...);
+			static Derived &make_derived(void); // never defined, T need not be default-constructible
 
 		public:
-			static const bool derived = sizeof(test_derived(Derived())) == sizeof(yes);
+			static const bool derived = sizeof(test_derived(make_derived())) == sizeof(yes);
 	};
 	#endif // GTHEADER_H
 
-	template<class T> class iVector
-	{
-		private:
-		// Attributes
-			husk_t core;	// important attributes, see class Husk
-			T *objects;		// generic pointer for the dynamic array
-
-			enum // Startup memory settings
-			{
-				FIRST_RESERVE_AMOUNT	= STARTUP_MEMORY_ALLOCATION_BLOCKS
-			};
-
-			/* Constant overflow management */
-			enum // using if: GT_ACTIVATE_AUTOMATIC_MODE_FOR_OVERFLOW == not defined
-			{
-				MINIMAL_OVERFLOW		= MINIMAL_OVERFLOW_FOR_CONSTANT_MODE,
-				MAXIMAL_OVERFLOW		= MAXIMAL_OVERFLOW_FOR_CONSTANT_MODE,
-				REMOVE_IF_IT_IS_LARGER	= REMOVE_IF_IT_IS_LARGER_FOR_CONSTANT_MODE
-			};
-
-			/* Dynamic overflow management */
-			enum // using if: GT_ACTIVATE_AUTOMATIC_MODE_FOR_OVERFLOW == are defined
-			{
-				AUTO_MINIMAL_OVERFLOW	= AUTO_MINIMAL_OVERFLOW_FOR_DYNAMIC_MODE,
-				AUTO_MAXIMAL_OVERFLOW	= AUTO_MAXIMAL_OVERFLOW_FOR_DYNAMIC_MODE,
-				ADJUST_BASE_NUMBER		= ADJUST_BASE_NUMBER_FOR_DYNAMIC_MODE,
-				INITIAL_BASE_VALUE		= INITIAL_BASE_VALUE_FOR_DYNAMIC_MODE
-			};
-
+	/* Trait: is_trivially_relocatable<T>:
+		A trivially relocatable type can be moved to another address by copying its bytes,
+		without calling the move ctor and the dtor of the source. The iVector then grows with
+		realloc and shifts elements with memmove. Trivially copyable types are relocatable
+		by default. Specialize the trait for your own types to opt in, for example:
+			template<> struct GT::is_trivially_relocatable<MyType>: std::true_type{};
+	*/
+	template<class T> struct is_trivially_relocatable:
+		std::integral_constant<bool, std::is_trivially_copyable<T>::value>{};
 
-		// Private methods
+	namespace detail
+	{
+		/* Raw storage helpers:
+			The containers only hold uninitialized memory. Elements are
+			constructed and destroyed in the live range [0, size) only.
+			See the allocator aware versions below for the iVector.
+		*/
+		/* Returns storage for n objects, null if out of memory or if sizeof(T) * n overflows */
+		template<class T> inline T *allocate_raw(const size_t n)
+		{
+			if(n > size_t(-1) / sizeof(T)) return null_ptr;
+			return static_cast<T *>(std::malloc(sizeof(T) * (n != 0 ? n : 1)));
+		}
 
-			/* Using the bitshift left operator to calc the new overflow for ascending */
-			inline size_t shift_left(void);
+		template<class T> inline void deallocate_raw(T *p)
+		{
+			std::free(static_cast<void *>(p));
+		}
 
-			/* Using the bitshift operator right to calc the new overflow for ascending */
-			inline size_t shift_right(void);
+		template<class T> inline void destroy_range(T *first, T *last)
+		{
+			for(; first != last; ++first) first->~T();
+		}
 
-			/* Delete an element using the index */
-			inline void kill_item(const size_t index);
+		/* Move-constructs [first, last) into raw storage at dest if T can be moved without
+		   throwing (or cannot be copied at all), otherwise copies. Returns the end of dest. */
+		template<class T> inline T *uninitialized_move_if_noexcept(T *first, T *last, T *dest, std::true_type)
+		{
+			return std::uninitialized_copy(std::make_move_iterator(first), std::make_move_iterator(last), dest);
+		}
 
-			/* Set new core settings */
-			inline void setCore(const husk_t &src);
+		template<class T> inline T *uninitialized_move_if_noexcept(T *first, T *last, T *dest, std::false_type)
+		{
+			return std::uninitialized_copy(first, last, dest);
+		}
 
+		template<class T> inline T *uninitialized_move_if_noexcept(T *first, T *last, T *dest)
+		{
+			return uninitialized_move_if_noexcept(first, last, dest, std::integral_constant<bool,
+					std::is_nothrow_move_constructible<T>::value || !std::is_copy_constructible<T>::value>());
+		}
 
-		public:
+		/* Copy-constructs [first, last) into raw storage at dest. Returns the end of dest. */
+		template<class T> inline T *uninitialized_copy_range(const T *first, const T *last, T *dest, std::true_type)
+		{
+			if(first != last) std::memcpy(static_cast<void *>(dest), static_cast<const void *>(first), sizeof(T) * (last - first));
+			return dest + (last - first);
+		}
 
-		// Iterator types
-			typedef T *iterator;
-			typedef const T *const_iterator;
-			typedef reverse_iterator_t<T> reverse_iterator;
-			typedef const reverse_iterator_t<T> const_reverse_iterator;
+		template<class T> inline T *uninitialized_copy_range(const T *first, const T *last, T *dest, std::false_type)
+		{
+			return std::uninitialized_copy(first, last, dest);
+		}
 
+		template<class T> inline T *uninitialized_copy_range(const T *first, const T *last, T *dest)
+		{
+			return uninitialized_copy_range(first, last, dest, std::integral_constant<bool, std::is_trivially_copyable<T>::value>());
+		}
 
-		// Constructors
+		/* Transfers [first, last) into raw storage at dest and ends the lifetime of the source objects. */
+		template<class T> inline T *relocate_range(T *first, T *last, T *dest, std::true_type)
+		{
+			if(first != last) std::memcpy(static_cast<void *>(dest), static_cast<const void *>(first), sizeof(T) * (last - first));
+			return dest + (last - first);
+		}
 
-			/* Creates a iVector of length n, containing n copies of the default value for type T.
-			 * Requires that constructor have a number. */
-			inline explicit iVector(const size_t initCapacity = 0):
-				// 1. ascending   2. bearingsCount   3. actualSize   4. actualCapacity
-				core(INITIAL_BASE_VALUE, 0, 0, initCapacity > ((FIRST_RESERVE_AMOUNT < 1) ? 1 : FIRST_RESERVE_AMOUNT) ?
-						 initCapacity : ((FIRST_RESERVE_AMOUNT < 1) ? 1 : FIRST_RESERVE_AMOUNT)),
-				objects(GT_ALLOCATER_T T[this->core.actualCapacity != 0 ? this->core.actualCapacity : 1]){}
+		template<class T> inline T *relocate_range(T *first, T *last, T *dest, std::false_type)
+		{
+			T *result = uninitialized_move_if_noexcept(first, last, dest);
+			destroy_range(first, last);
+			return result;
+		}
 
-			/* Creates a iVector of length n, containing n copies of value. */
-			inline explicit iVector(const T &src, const size_t size = 1):
-				core(INITIAL_BASE_VALUE, 0, size, (FIRST_RESERVE_AMOUNT < size) ? (size + 1) : FIRST_RESERVE_AMOUNT),
-				objects(GT_ALLOCATER_T T[(FIRST_RESERVE_AMOUNT < size) ? (size + 1) : FIRST_RESERVE_AMOUNT])
-			{	// 1. ascending   2. bearingsCount   3. actualSize   4. actualCapacity
-				for(size_t i=0; i<size; i++) this->operator[](i) = src;
-			}
+		template<class T> inline T *relocate_range(T *first, T *last, T *dest)
+		{
+			return relocate_range(first, last, dest, is_trivially_relocatable<T>());
+		}
 
-			/* The copy ctor Creates a copy of src. */
-			inline iVector(const iVector<T> &src): core(src.getCore())
-			{
-				this->core.actualSize = 0;
-				this->objects = GT_ALLOCATER_T T[src.capacity()];
-				iterator i = this->begin();
-				for(const_iterator it = src.begin(); it != src.end(); it++, i++) *i = *it;
-				this->setCore(src.getCore());
-			}
+		/* Transfers [first, last) to dest like memmove, the ranges may overlap. The part
+		   of the target range that does not overlap the source must be unconstructed. */
+		template<class T> inline void relocate_overlapping(T *first, T *last, T *dest, std::true_type)
+		{
+			if(first != last) std::memmove(static_cast<void *>(dest), static_cast<const void *>(first), sizeof(T) * (last - first));
+		}
 
-			/* Ctor to convert and creates a copy of src. */
-			template<class Y> inline iVector(const iVector<Y> &src): core(src.getCore())
-			{
-				this->core.actualSize = 0;
-				if(is<T, Y>::derived) // Check if Y is a derivation of T
+		template<class T> inline void relocate_overlapping(T *first, T *last, T *dest, std::false_type)
+		{
+			if(dest < first)
+				for(; first != last; ++first, ++dest)
 				{
-					this->objects = GT_ALLOCATER_T T[src.capacity()];
-					iterator i = this->begin();
-					for(const Y *it = src.begin(); it != src.end(); it++, i++) *i = *it;
-					this->setCore(src.getCore());
+					::new(static_cast<void *>(dest)) T(std::move(*first));
+					first->~T();
 				}
-				else
+			else
+				for(dest += last - first; last != first; )
 				{
-                    #ifdef GT_CERR_ACTIVE
-					std::cerr << "IN FUNCTION: template<class Y> inline iVector(const iVector<Y> &src);" << std::endl;
-					std::cerr << "is<T, Y>::derived == false -> DATATYPE IS NOT COMPATIBLE!" << std::endl;
-                    #endif
-					this->core.setHusk(INITIAL_BASE_VALUE, 0, 0, (FIRST_RESERVE_AMOUNT < 1) ? 1 : FIRST_RESERVE_AMOUNT);
-					this->objects = GT_ALLOCATER_T T[this->core.actualCapacity != 0 ? this->core.actualCapacity : 1];
+					::new(static_cast<void *>(--dest)) T(std::move(*--last));
+					last->~T();
 				}
-			}
-
+		}
 
-		// Destructor
-			~iVector();
+		template<class T> inline void relocate_overlapping(T *first, T *last, T *dest)
+		{
+			relocate_overlapping(first, last, dest, is_trivially_relocatable<T>());
+		}
+	} // end of namespace detail
 
+	/* Class: allocator<T>:
+		The default allocator of the iVector. The memory comes from malloc, so trivially
+		relocatable elements can grow in place by realloc, see reallocate. Any allocator
+		that honors std::allocator_traits can be used instead, see GT::pmr::iVector.
+	*/
+	template<class T> struct allocator
+	{
+		typedef T value_type;
+		typedef std::true_type propagate_on_container_move_assignment;
+		typedef std::true_type is_always_equal;
 
-		// Methods
+		inline allocator(void) noexcept{}
+		template<class Y> inline allocator(const allocator<Y> &) noexcept{}
 
-			/* Sorts the elements in the range [first,last) into ascending order.
-			 * The elements are compared using operator< for the first version, and comp for the second.
-			 * Equivalent elements are not guaranteed to keep their original relative order (see stable_sort). */
-			inline void sort(void){std::sort(this->begin(), this->end());}
+		/* Returns uninitialized storage for n objects. Throws std::bad_alloc if out of memory. */
+		inline T *allocate(const size_t n)
+		{
+			void *p = n <= size_t(-1) / sizeof(T) ? std::malloc(sizeof(T) * (n != 0 ? n : 1)) : null_ptr;
+			if(p == null_ptr) throw std::bad_alloc();
+			return static_cast<T *>(p);
+		}
 
-			/* Using this->sort() and mirror method. */
-			inline void sort_reverse(void){this->sort(); this->mirror();}
+		/* Releases storage of allocate. */
+		inline void deallocate(T *p, const size_t) noexcept
+		{
+			std::free(static_cast<void *>(p));
+		}
 
-			/* return clone of this object */
-			inline iVector<T> *clone(void){return GT_ALLOCATER_T iVector<T>(*this);}
+		/* Resizes storage of allocate to n objects and keeps the bytes of the content.
+		 * Only valid for trivially relocatable T. Returns null if out of memory, p stays valid then. */
+		inline T *reallocate(T *p, const size_t, const size_t n) noexcept
+		{
+			if(n > size_t(-1) / sizeof(T)) return null_ptr;
+			return static_cast<T *>(std::realloc(static_cast<void *>(p), sizeof(T) * (n != 0 ? n : 1)));
+		}
+	};
 
-			/* Replaces elements in *this with n copies of t. The function invalidates all
-			 * iterators and references to elements in *this. */
-			inline void assign(const iVector<T> &src);
+	template<class T, class Y> inline bool operator==(const allocator<T> &, const allocator<Y> &){return true;}
+	template<class T, class Y> inline bool operator!=(const allocator<T> &, const allocator<Y> &){return false;}
 
-			/* Returns a constant reference to the first element. */
-			inline const T &front(void) const;
+	namespace detail
+	{
+		/* Trait: is_plain_allocator<A>:
+			True if construct and destroy of A are plain placement new and dtor calls. Only then
+			the allocator aware helpers below copy and relocate elements with memcpy and memmove.
+		*/
+		template<class A> struct is_plain_allocator: std::false_type{};
+		template<class T> struct is_plain_allocator<std::allocator<T> >: std::true_type{};
+		template<class T> struct is_plain_allocator<GT::allocator<T> >: std::true_type{};
+        #ifdef GT_HAS_MEMORY_RESOURCE
+		template<class T> struct is_plain_allocator<std::pmr::polymorphic_allocator<T> >:
+			std::integral_constant<bool, !std::uses_allocator<T, std::pmr::polymorphic_allocator<T> >::value>{};
+        #endif
+
+		/* Trait: has_reallocate<A, T>:
+			True if A offers T *reallocate(T *p, size_t oldN, size_t newN) like GT::allocator.
+		*/
+		template<class A, class T> struct has_reallocate
+		{
+			private:
+				template<class U> static std::true_type test(decltype(std::declval<U &>().reallocate(
+						std::declval<T *>(), size_t(), size_t())) *);
+				template<class U> static std::false_type test(...);
+			public:
+				static const bool value = decltype(test<A>(0))::value;
+		};
+
+		/* Trait: can_reallocate<A, T>: the storage of A grows in place for T, see has_reallocate. */
+		template<class A, class T> struct can_reallocate:
+			std::integral_constant<bool, is_trivially_relocatable<T>::value && has_reallocate<A, T>::value>{};
+
+		template<class A, class T> inline T *reallocate_storage(A &a, T *p, const size_t oldN, const size_t newN, std::true_type)
+		{
+			return a.reallocate(p, oldN, newN);
+		}
 
-			/* Returns a reference to the first element. */
-			inline T &front(void);
+		template<class A, class T> inline T *reallocate_storage(A &, T *, const size_t, const size_t, std::false_type)
+		{
+			return null_ptr;
+		}
 
-			/* Inserts a copy of x to the begin of self. */
-			inline void push_front(const T &x);
+		/* Allocator aware storage helpers:
+			The same operations as above for storage of the allocator a. The elements are
+			constructed and destroyed through std::allocator_traits, so an allocator like
+			std::pmr::polymorphic_allocator is passed on to the elements that use one.
+			If a construction throws, the elements constructed so far are destroyed.
+		*/
+		template<class A, class T> inline void destroy_range(A &a, T *first, T *last)
+		{
+			for(; first != last; ++first) std::allocator_traits<A>::destroy(a, first);
+		}
 
-			/* Inserts copies of the elements in the range [start, finish) before position. */
-			inline void insert(const T new_item, const size_t position = 0);
+		template<class A, class InputIterator, class T> inline T *uninitialized_copy_range(A &,
+				InputIterator first, InputIterator last, T *dest, std::true_type)
+		{
+			if(first != last) std::memcpy(static_cast<void *>(dest), static_cast<const void *>(&*first), sizeof(T) * (last - first));
+			return dest + (last - first);
+		}
 
-			/* Deletes the iVector element from the index position begin and deletes any desired number of items. */
-			inline void erase(const size_t begin, const size_t pieces = 1);
-			inline void erase(const_iterator it, const size_t pieces = 1)
+		template<class A, class InputIterator, class T> inline T *uninitialized_copy_range(A &a,
+				InputIterator first, InputIterator last, T *dest, std::false_type)
+		{
+			T *current = dest;
+			try
 			{
-				if(pieces > 0)
-					if(this->size() != 0)
-					{
-						iterator t = GT_ALLOCATER_T T[
-								this->capacity() > 1 ? (this->capacity() - 1) > 1 ? this->capacity() - 1 : 1 : 1], temp = t;
-						for(const_iterator i = this->begin(); i != this->end(); i++, t++)
-							if(i != it) *t = *i; else {t--; (i + pieces - 1) > this->end() ? i = this->end() : i += pieces - 1;}
-
-						this->core.setHusk(this->core.ascending, this->core.bearingsCount,
-										   (this->size() - pieces) < 1 ? 1 : this->size() - pieces,
-										   this->capacity() > 1 ? (this->capacity() - 1) > 1 ? this->capacity() - 1 : 1 : 1);
-						delete[] this->objects;
-						this->objects = temp;
-					}
+				for(; first != last; ++first, ++current) std::allocator_traits<A>::construct(a, current, *first);
+			}
+			catch(...)
+			{
+				destroy_range(a, dest, current);
+				throw;
 			}
+			return current;
+		}
 
-			/* Alters the size of self. If the new size (sz) is greater than the current size,
-			 * then sz-size() instances of the default value of type T are inserted at the end of the iVector.
-			 * If the new size is smaller than the current capacity, then the iVector is truncated by erasing
-			 * size()-sz elements off the end. If sz is equal to capacity then no action is taken. */
-			inline void resize(const size_t newSize);
+		template<class A, class InputIterator, class T> inline T *uninitialized_copy_range(A &a,
+				InputIterator first, InputIterator last, T *dest)
+		{
+			return uninitialized_copy_range(a, first, last, dest, std::integral_constant<bool,
+					std::is_pointer<InputIterator>::value && std::is_trivially_copyable<T>::value && is_plain_allocator<A>::value &&
+					std::is_same<typename std::remove_cv<typename std::remove_pointer<InputIterator>::type>::type, T>::value>());
+		}
 
-			/* Increases the capacity of self in anticipation of adding new elements.
-			 * reserve itself does not add any new elements. After a call to reserve,
-			 * capacity() is greater than or equal to n and subsequent insertions will
-			 * not cause a reallocation until the size of the iVector exceeds n. Reallocation
-			 * does not occur if n is less than capacity(). If reallocation does occur,
-			 * then all iterators and references pointing to elements in the iVector are invalidated.
-			 * reserve takes at most linear time in the size of self. reserve throws a length_error
-			 * exception if n is greater than max_size(). */
-			inline void reserve(const size_t newCapacity);
+		template<class A, class T> inline T *uninitialized_fill_range(A &a, T *dest, const size_t n, const T &x)
+		{
+			T *current = dest;
+			try
+			{
+				for(; current != dest + n; ++current) std::allocator_traits<A>::construct(a, current, x);
+			}
+			catch(...)
+			{
+				destroy_range(a, dest, current);
+				throw;
+			}
+			return current;
+		}
 
-			/* Returns true if the size is zero. */
-			inline bool empty(void) const;
+		template<class A, class T> inline T *uninitialized_move_if_noexcept(A &a, T *first, T *last, T *dest)
+		{
+			T *current = dest;
+			try
+			{
+				for(; first != last; ++first, ++current) std::allocator_traits<A>::construct(a, current, std::move_if_noexcept(*first));
+			}
+			catch(...)
+			{
+				destroy_range(a, dest, current);
+				throw;
+			}
+			return current;
+		}
 
-			/* Returns the number of elements. */
-			inline size_t size(void) const;
+		template<class A, class T> inline T *relocate_range(A &a, T *first, T *last, T *dest)
+		{
+			if(is_trivially_relocatable<T>::value && is_plain_allocator<A>::value)
+				return relocate_range(first, last, dest, std::true_type());
+			T *result = uninitialized_move_if_noexcept(a, first, last, dest);
+			destroy_range(a, first, last);
+			return result;
+		}
 
-			/* Returns the size of the allocated storage, as the number of elements that can be stored. */
-			inline size_t capacity(void) const;
+		template<class A, class T> inline void relocate_overlapping(A &a, T *first, T *last, T *dest)
+		{
+			if(is_trivially_relocatable<T>::value && is_plain_allocator<A>::value)
+				relocate_overlapping(first, last, dest, std::true_type());
+			else if(dest < first)
+				for(; first != last; ++first, ++dest)
+				{
+					std::allocator_traits<A>::construct(a, dest, std::move(*first));
+					std::allocator_traits<A>::destroy(a, first);
+				}
+			else
+				for(dest += last - first; last != first; )
+				{
+					std::allocator_traits<A>::construct(a, --dest, std::move(*--last));
+					std::allocator_traits<A>::destroy(a, last);
+				}
+		}
 
-			/* Inserts a copy of x to the end of self. */
-			inline void push_back(const T &x);
+		/* Copies or swaps allocators only if the propagate trait of std::allocator_traits is set. */
+		template<class A> inline void assign_allocator(A &dest, const A &src, std::true_type){dest = src;}
+		template<class A> inline void assign_allocator(A &, const A &, std::false_type){}
+		template<class A> inline void swap_allocator(A &a, A &b, std::true_type){using std::swap; swap(a, b);}
+		template<class A> inline void swap_allocator(A &, A &, std::false_type){}
 
-			/* Removes the first element of self. */
-			inline void pop_front(void);
+		/* Class: allocator_holder<A>:
+			Holds the allocator of a container. An empty allocator takes no space (empty base optimization).
+		*/
+		template<class A, bool = std::is_empty<A>::value> class allocator_holder: private A
+		{
+			protected:
+				inline explicit allocator_holder(const A &a): A(a){}
+				inline A &allocator_ref(void){return *this;}
+				inline const A &allocator_ref(void) const{return *this;}
+		};
 
-			/* Removes the last element of self. */
-			inline void pop_back(void);
+		template<class A> class allocator_holder<A, false>
+		{
+			private:
+				A alloc;
+			protected:
+				inline explicit allocator_holder(const A &a): alloc(a){}
+				inline A &allocator_ref(void){return this->alloc;}
+				inline const A &allocator_ref(void) const{return this->alloc;}
+		};
+	} // end of namespace detail
+
+	/* Codec: codec<T>:
+		Writes and reads single elements for iVector::save, iVector::load and the snapshot streams.
+		Trivially copyable types are raw: the array is written and read as one block of bytes.
+		Specialize codec for other types, or pass any object with these members:
+			static const bool raw = false;
+			bool write(std::ostream &os, const T &x) const;
+			bool read(std::istream &is, T &x) const;	// x is default constructed
+		A codec for std::basic_string is included.
+	*/
+	template<class T, bool = std::is_trivially_copyable<T>::value> struct codec
+	{
+		static const bool raw = true;
 
-			/* Returns a reference to the last element. */
-			inline T &back(void);
+		inline bool write(std::ostream &os, const T &x) const
+		{
+			return bool(os.write(reinterpret_cast<const char *>(&x), sizeof(T)));
+		}
 
-			/* Returns a constant reference to the last element. */
-			inline const T &back(void) const;
+		inline bool read(std::istream &is, T &x) const
+		{
+			return bool(is.read(reinterpret_cast<char *>(&x), sizeof(T)));
+		}
+	};
 
-			/* Returns a reference to element n of self. The result can be used as an lvalue.
-			 * The index n must be between 0 and the size less one. */
-			inline T &at(const size_t index);
+	template<class T> struct codec<T, false>
+	{	// no default encoding, see above
+		static const bool raw = false;
+	};
 
-			/* Returns a constant reference to element n of self.
-			 * The index n must be between 0 and the size less one. */
-			inline const T &at(const size_t index) const;
+	template<class C, class Traits, class A> struct codec<std::basic_string<C, Traits, A>, false>
+	{	// length followed by the characters
+		static const bool raw = false;
 
-			/* Deletes all elements from the iVector. */
-			inline void clear(void);
+		inline bool write(std::ostream &os, const std::basic_string<C, Traits, A> &x) const
+		{
+			const uint64_t length = x.size();
+			return os.write(reinterpret_cast<const char *>(&length), sizeof(length))
+				&& os.write(reinterpret_cast<const char *>(x.data()), std::streamsize(sizeof(C) * length));
+		}
 
-			/* Exchanges self with src, by swapping all elements. */
-			inline void swap(iVector<T> &src);
+		inline bool read(std::istream &is, std::basic_string<C, Traits, A> &x) const
+		{
+			uint64_t length = 0;
+			if(!is.read(reinterpret_cast<char *>(&length), sizeof(length)) || length > x.max_size()) return false;
+			// a broken length must not allocate more than the stream holds: grow by pieces until EOF
+			const size_t PIECE = 65536 / sizeof(C);
+			x.clear();
+			while(x.size() < length)
+			{
+				const size_t at = x.size(), n = size_t(std::min<uint64_t>(length - at, PIECE));
+				x.resize(at + n);
+				if(!is.read(reinterpret_cast<char *>(&x[at]), std::streamsize(sizeof(C) * n))) return false;
+			}
+			return true;
+		}
+	};
 
-			/* Return actual core */
-			inline husk_t getCore(void) const;
+	namespace detail
+	{
+		/* The binary snapshot format of iVector::save:
+			header, then the elements. A chunked snapshot (iSnapshotWriter) holds chunks of
+			[uint64_t count, count elements] instead, terminated by a count of 0. The size is
+			SNAPSHOT_UNKNOWN if the writer could not seek back to fill it in. The byte order
+			is the one of the writer. */
+		struct snapshot_header
+		{
+			char magic[8];			// "GTIVSNP"
+			uint32_t version;		// SNAPSHOT_VERSION
+			uint32_t flags;			// SNAPSHOT_RAW, SNAPSHOT_CHUNKED
+			uint64_t elementSize;	// sizeof(T) of raw elements, 0 for a codec
+			uint64_t size;			// number of elements
+		};
+
+		static const uint32_t SNAPSHOT_VERSION = 1;
+		static const uint32_t SNAPSHOT_RAW = 1, SNAPSHOT_CHUNKED = 2;
+		static const uint64_t SNAPSHOT_UNKNOWN = ~uint64_t(0);
+
+		inline snapshot_header make_snapshot_header(const bool raw, const size_t elementSize, const bool chunked, const uint64_t size)
+		{
+			snapshot_header header;
+			std::memcpy(header.magic, "GTIVSNP", 8);
+			header.version = SNAPSHOT_VERSION;
+			header.flags = (raw ? SNAPSHOT_RAW : 0) | (chunked ? SNAPSHOT_CHUNKED : 0);
+			header.elementSize = raw ? elementSize : 0;
+			header.size = size;
+			return header;
+		}
 
-			/* Changes the Direction of all elements. */
-			inline void mirror(void);
+        #ifdef GT_HAS_UNISTD
+		/* Class: fd_streambuf:
+			A buffered stream on a POSIX file descriptor for iVector::save(int) and load(int).
+			Blocks larger than the buffer are passed to read and write directly. */
+		class fd_streambuf: public std::streambuf
+		{
+			private:
+				int fd;
+				char buffer[1 << 16];
 
+				inline bool write_all(const char *s, size_t n)
+				{
+					while(n != 0)
+					{
+						const ssize_t written = ::write(this->fd, s, n);
+						if(written <= 0) return false;
+						s += written; n -= size_t(written);
+					}
+					return true;
+				}
 
-		// Operators
+			protected:
+				inline int sync(void)
+				{
+					if(this->pbase() == this->pptr()) return 0;
+					const bool ok = this->write_all(this->pbase(), size_t(this->pptr() - this->pbase()));
+					this->setp(this->buffer, this->buffer + sizeof(this->buffer));
+					return ok ? 0 : -1;
+				}
 
-			/* Caution: Note the size of the datatypes! */
-			/* First check if Y are a derivation of T. Is the datatype correct cast the iVector obj in the basic Y* datatype */
+				inline int_type overflow(int_type c)
+				{
+					if(this->sync() != 0) return traits_type::eof();
+					if(!traits_type::eq_int_type(c, traits_type::eof())) this->sputc(traits_type::to_char_type(c));
+					return traits_type::not_eof(c);
+				}
+
+				inline std::streamsize xsputn(const char *s, std::streamsize n)
+				{
+					if(n < std::streamsize(sizeof(this->buffer))) return std::streambuf::xsputn(s, n);
+					return this->sync() == 0 && this->write_all(s, size_t(n)) ? n : 0;
+				}
+
+				inline int_type underflow(void)
+				{
+					const ssize_t got = ::read(this->fd, this->buffer, sizeof(this->buffer));
+					if(got <= 0) return traits_type::eof();
+					this->setg(this->buffer, this->buffer, this->buffer + got);
+					return traits_type::to_int_type(this->buffer[0]);
+				}
+
+				inline std::streamsize xsgetn(char *s, std::streamsize n)
+				{
+					std::streamsize done = std::min<std::streamsize>(n, this->egptr() - this->gptr());
+					std::memcpy(s, this->gptr(), size_t(done));
+					this->gbump(int(done));
+					if(n - done < std::streamsize(sizeof(this->buffer))) return done + std::streambuf::xsgetn(s + done, n - done);
+					while(done < n)
+					{
+						const ssize_t got = ::read(this->fd, s + done, size_t(n - done));
+						if(got <= 0) break;
+						done += got;
+					}
+					return done;
+				}
+
+			public:
+				inline explicit fd_streambuf(const int fd): fd(fd)
+				{
+					this->setp(this->buffer, this->buffer + sizeof(this->buffer));
+					this->setg(this->buffer, this->buffer, this->buffer);
+				}
+
+				inline ~fd_streambuf(){this->sync();}
+		};
+        #endif
+	} // end of namespace detail
+
+	template<class T, class Codec = codec<T> > class iSnapshotReader;
+	template<class T> class iSpan;
+
+	namespace detail
+	{
+		/* Arithmetic types the search kernels keep in SIMD registers */
+		template<class T> struct is_simd_arithmetic: std::integral_constant<bool, std::is_arithmetic<T>::value && !std::is_same<T, bool>::value
+				&& (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)>{};
+
+		/* Plain loops for the search members of iVector and the reference of the SIMD kernels.
+		 * min_element and max_element return the first extremum like std::min_element and
+		 * std::max_element, sum and dot add from left to right. */
+		struct scalar_search
+		{
+			template<class T> static inline size_t find(const T *p, const size_t n, const T &x)
+			{
+				for(size_t i=0; i<n; i++)
+					if(p[i] == x) return i;
+				return n;
+			}
+
+			template<class T> static inline size_t count(const T *p, const size_t n, const T &x)
+			{
+				size_t c = 0;
+				for(size_t i=0; i<n; i++)
+					if(p[i] == x) c++;
+				return c;
+			}
+
+			template<class T> static inline size_t min_element(const T *p, const size_t n)
+			{
+				size_t best = 0;
+				for(size_t i=1; i<n; i++)
+					if(p[i] < p[best]) best = i;
+				return best;
+			}
+
+			template<class T> static inline size_t max_element(const T *p, const size_t n)
+			{
+				size_t best = 0;
+				for(size_t i=1; i<n; i++)
+					if(p[best] < p[i]) best = i;
+				return best;
+			}
+
+			template<class T> static inline T sum(const T *p, const size_t n)
+			{
+				T s = T();
+				for(size_t i=0; i<n; i++) s += p[i];
+				return s;
+			}
+
+			template<class T> static inline T dot(const T *a, const T *b, const size_t n)
+			{
+				T s = T();
+				for(size_t i=0; i<n; i++) s += a[i] * b[i];
+				return s;
+			}
+		};
+
+		template<class T, bool = is_simd_arithmetic<T>::value> struct search: scalar_search{};
+
+    #ifdef GT_HAS_SIMD
+		namespace simd
+		{
+			/* Instruction sets of the kernels */
+			enum isa{NONE, SSE2, AVX2, AVX512};
+
+			inline isa detect(void)
+			{
+				__builtin_cpu_init();
+				if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl"))
+					return AVX512;
+				if(__builtin_cpu_supports("avx2")) return AVX2;
+				if(__builtin_cpu_supports("sse2")) return SSE2;
+				return NONE;
+			}
+
+			/* Returns the best instruction set of this CPU, detected once */
+			inline isa cpu(void)
+			{
+				static const isa best = detect();
+				return best;
+			}
+
+			/* Integers are added in unsigned lanes, where an overflow wraps around */
+			template<class T, bool = std::is_integral<T>::value> struct lane{typedef T type;};
+			template<class T> struct lane<T, true>{typedef typename std::make_unsigned<T>::type type;};
+
+			/* The kernels on BYTES wide vectors. They are inlined into the functions of sse2, avx2
+			 * and avx512 below, which compile them for their instruction set. */
+			template<class T, size_t BYTES> struct kernel
+			{
+				typedef T vec __attribute__((vector_size(BYTES)));
+				typedef decltype(vec() == vec()) mask;
+				typedef typename lane<T>::type U;
+				typedef U uvec __attribute__((vector_size(BYTES)));
+				typedef typename std::common_type<U, unsigned>::type W;	// U without promotion to int
+				static const size_t L = BYTES / sizeof(T);	// lanes
+
+				template<class V> static inline __attribute__((always_inline)) void load(V &v, const T *p){std::memcpy(&v, p, BYTES);}
+
+				static inline __attribute__((always_inline)) bool any(const mask &m)
+				{
+					uint64_t w[BYTES / 8], r = 0;
+					std::memcpy(w, &m, BYTES);
+					for(size_t k=0; k<BYTES / 8; k++) r |= w[k];
+					return r != 0;
+				}
+
+				static inline __attribute__((always_inline)) size_t find(const T *p, const size_t n, const T x)
+				{
+					const vec vx = vec() + x;
+					size_t i = 0;
+					for(; i + 4 * L <= n; i += 4 * L)
+					{	// the block with the match is searched below. The masks are added, not ored,
+						// because GCC splits the or of two compares into scalar code on AVX-512.
+						vec a, b, c, d;
+						load(a, p + i); load(b, p + i + L); load(c, p + i + 2 * L); load(d, p + i + 3 * L);
+						if(any((a == vx) + (b == vx) + (c == vx) + (d == vx))) break;
+					}
+					for(; i < n; i++)
+						if(p[i] == x) return i;
+					return n;
+				}
+
+				static inline __attribute__((always_inline)) size_t count(const T *p, const size_t n, const T x)
+				{
+					const vec vx = vec() + x;
+					size_t c = 0, i = 0;
+					for(size_t blocks = n / L; blocks != 0;)
+					{	// a match subtracts -1 from its lane, 127 rounds fit into 8 bit lanes
+						const size_t rounds = blocks < 127 ? blocks : 127;
+						mask acc = mask();
+						for(size_t r=0; r<rounds; r++, i += L)
+						{
+							vec a;
+							load(a, p + i);
+							acc -= (a == vx);
+						}
+						for(size_t k=0; k<L; k++) c += size_t(acc[k]);
+						blocks -= rounds;
+					}
+					for(; i < n; i++)
+						if(p[i] == x) c++;
+					return c;
+				}
+
+				/* Returns the smallest element or max() (infinity), NaNs are skipped */
+				static inline __attribute__((always_inline)) T min(const T *p, const size_t n)
+				{
+					const T init = std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+					vec m = vec() + init;
+					size_t i = 0;
+					for(; i + L <= n; i += L)
+					{
+						vec a;
+						load(a, p + i);
+						m = a < m ? a : m;
+					}
+					T r = init;
+					for(size_t k=0; k<L; k++)
+						if(m[k] < r) r = m[k];
+					for(; i < n; i++)
+						if(p[i] < r) r = p[i];
+					return r;
+				}
+
+				/* Returns the largest element or lowest() (-infinity), NaNs are skipped */
+				static inline __attribute__((always_inline)) T max(const T *p, const size_t n)
+				{
+					const T init = std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+					vec m = vec() + init;
+					size_t i = 0;
+					for(; i + L <= n; i += L)
+					{
+						vec a;
+						load(a, p + i);
+						m = m < a ? a : m;
+					}
+					T r = init;
+					for(size_t k=0; k<L; k++)
+						if(r < m[k]) r = m[k];
+					for(; i < n; i++)
+						if(r < p[i]) r = p[i];
+					return r;
+				}
+
+				static inline __attribute__((always_inline)) T sum(const T *p, const size_t n)
+				{
+					uvec s0 = uvec(), s1 = uvec(), s2 = uvec(), s3 = uvec();
+					size_t i = 0;
+					for(; i + 4 * L <= n; i += 4 * L)
+					{
+						uvec a, b, c, d;
+						load(a, p + i); load(b, p + i + L); load(c, p + i + 2 * L); load(d, p + i + 3 * L);
+						s0 += a; s1 += b; s2 += c; s3 += d;
+					}
+					for(; i + L <= n; i += L)
+					{
+						uvec a;
+						load(a, p + i);
+						s0 += a;
+					}
+					s0 = (s0 + s1) + (s2 + s3);
+					U r = U();
+					for(size_t k=0; k<L; k++) r += s0[k];
+					for(; i < n; i++) r += U(p[i]);
+					return T(r);
+				}
+
+				static inline __attribute__((always_inline)) T dot(const T *x, const T *y, const size_t n)
+				{
+					uvec s0 = uvec(), s1 = uvec();
+					size_t i = 0;
+					for(; i + 2 * L <= n; i += 2 * L)
+					{
+						uvec a, b, c, d;
+						load(a, x + i); load(b, y + i); load(c, x + i + L); load(d, y + i + L);
+						s0 += a * b; s1 += c * d;
+					}
+					for(; i + L <= n; i += L)
+					{
+						uvec a, b;
+						load(a, x + i); load(b, y + i);
+						s0 += a * b;
+					}
+					s0 += s1;
+					U r = U();
+					for(size_t k=0; k<L; k++) r += s0[k];
+					for(; i < n; i++) r += U(W(x[i]) * W(y[i]));
+					return T(r);
+				}
+
+				/* Reverses the elements in [first, last) by swapping whole vectors from both ends */
+				static inline __attribute__((always_inline)) void reverse(T *first, T *last)
+				{
+					mask order;
+					for(size_t k=0; k<L; k++) order[k] = typename std::remove_reference<decltype(order[0])>::type(L - 1 - k);
+					for(; last - first >= std::ptrdiff_t(2 * L); first += L)
+					{
+						last -= L;
+						vec a, b;
+						load(a, first); load(b, last);
+                    #ifdef __clang__
+						a = __builtin_shufflevector(a, a, order); b = __builtin_shufflevector(b, b, order);
+                    #else
+						a = __builtin_shuffle(a, order); b = __builtin_shuffle(b, order);
+                    #endif
+						std::memcpy(first, &b, BYTES); std::memcpy(last, &a, BYTES);
+					}
+					std::reverse(first, last);
+				}
+			};
+
+			template<class T> struct sse2
+			{
+				__attribute__((target("sse2"))) static size_t find(const T *p, const size_t n, const T x){return kernel<T, 16>::find(p, n, x);}
+				__attribute__((target("sse2"))) static size_t count(const T *p, const size_t n, const T x){return kernel<T, 16>::count(p, n, x);}
+				__attribute__((target("sse2"))) static T min(const T *p, const size_t n){return kernel<T, 16>::min(p, n);}
+				__attribute__((target("sse2"))) static T max(const T *p, const size_t n){return kernel<T, 16>::max(p, n);}
+				__attribute__((target("sse2"))) static T sum(const T *p, const size_t n){return kernel<T, 16>::sum(p, n);}
+				__attribute__((target("sse2"))) static T dot(const T *a, const T *b, const size_t n){return kernel<T, 16>::dot(a, b, n);}
+				__attribute__((target("sse2"))) static void reverse(T *first, T *last){kernel<T, 16>::reverse(first, last);}
+			};
+
+			template<class T> struct avx2
+			{
+				__attribute__((target("avx2"))) static size_t find(const T *p, const size_t n, const T x){return kernel<T, 32>::find(p, n, x);}
+				__attribute__((target("avx2"))) static size_t count(const T *p, const size_t n, const T x){return kernel<T, 32>::count(p, n, x);}
+				__attribute__((target("avx2"))) static T min(const T *p, const size_t n){return kernel<T, 32>::min(p, n);}
+				__attribute__((target("avx2"))) static T max(const T *p, const size_t n){return kernel<T, 32>::max(p, n);}
+				__attribute__((target("avx2"))) static T sum(const T *p, const size_t n){return kernel<T, 32>::sum(p, n);}
+				__attribute__((target("avx2"))) static T dot(const T *a, const T *b, const size_t n){return kernel<T, 32>::dot(a, b, n);}
+				__attribute__((target("avx2"))) static void reverse(T *first, T *last){kernel<T, 32>::reverse(first, last);}
+			};
+
+			template<class T> struct avx512
+			{
+				__attribute__((target("avx512f,avx512bw,avx512dq,avx512vl"))) static size_t find(const T *p, const size_t n, const T x){return kernel<T, 64>::find(p, n, x);}
+				__attribute__((target("avx512f,avx512bw,avx512dq,avx512vl"))) static size_t count(const T *p, const size_t n, const T x){return kernel<T, 64>::count(p, n, x);}
+				__attribute__((target("avx512f,avx512bw,avx512dq,avx512vl"))) static T min(const T *p, const size_t n){return kernel<T, 64>::min(p, n);}
+				__attribute__((target("avx512f,avx512bw,avx512dq,avx512vl"))) static T max(const T *p, const size_t n){return kernel<T, 64>::max(p, n);}
+				__attribute__((target("avx512f,avx512bw,avx512dq,avx512vl"))) static T sum(const T *p, const size_t n){return kernel<T, 64>::sum(p, n);}
+				__attribute__((target("avx512f,avx512bw,avx512dq,avx512vl"))) static T dot(const T *a, const T *b, const size_t n){return kernel<T, 64>::dot(a, b, n);}
+				__attribute__((target("avx512f,avx512bw,avx512dq,avx512vl"))) static void reverse(T *first, T *last){kernel<T, 64>::reverse(first, last);}
+			};
+
+			/* The kernels of one instruction set for T */
+			template<class T> struct table
+			{
+				size_t (*find)(const T *, const size_t, const T);
+				size_t (*count)(const T *, const size_t, const T);
+				T (*min)(const T *, const size_t);
+				T (*max)(const T *, const size_t);
+				T (*sum)(const T *, const size_t);
+				T (*dot)(const T *, const T *, const size_t);
+				void (*reverse)(T *, T *);
+			};
+
+			template<class T, template<class> class ISA> inline table<T> make_table(void)
+			{
+				const table<T> t = {ISA<T>::find, ISA<T>::count, ISA<T>::min, ISA<T>::max, ISA<T>::sum, ISA<T>::dot, ISA<T>::reverse};
+				return t;
+			}
+
+			/* Returns the kernels for this CPU, null if it has no SSE2 */
+			template<class T> inline const table<T> *select(void)
+			{
+				static const table<T> kernels = cpu() == AVX512 ? make_table<T, avx512>() : cpu() == AVX2 ? make_table<T, avx2>() : make_table<T, sse2>();
+				return cpu() != NONE ? &kernels : null_ptr;
+			}
+		} // end of namespace simd
+
+		/* The search members for arithmetic T. min_element and max_element find the extremum
+		 * and then its first position, a NaN at the front is the result like in the loops. */
+		template<class T> struct search<T, true>
+		{
+			static inline size_t find(const T *p, const size_t n, const T &x)
+			{
+				const simd::table<T> *k = simd::select<T>();
+				return k != null_ptr ? k->find(p, n, x) : scalar_search::find(p, n, x);
+			}
+
+			static inline size_t count(const T *p, const size_t n, const T &x)
+			{
+				const simd::table<T> *k = simd::select<T>();
+				return k != null_ptr ? k->count(p, n, x) : scalar_search::count(p, n, x);
+			}
+
+			static inline size_t min_element(const T *p, const size_t n)
+			{
+				const simd::table<T> *k = simd::select<T>();
+				if(k == null_ptr) return scalar_search::min_element(p, n);
+				if(n == 0 || !(p[0] == p[0])) return 0;
+				const size_t i = k->find(p, n, k->min(p, n));
+				return i < n ? i : 0;
+			}
+
+			static inline size_t max_element(const T *p, const size_t n)
+			{
+				const simd::table<T> *k = simd::select<T>();
+				if(k == null_ptr) return scalar_search::max_element(p, n);
+				if(n == 0 || !(p[0] == p[0])) return 0;
+				const size_t i = k->find(p, n, k->max(p, n));
+				return i < n ? i : 0;
+			}
+
+			static inline T sum(const T *p, const size_t n)
+			{
+				const simd::table<T> *k = simd::select<T>();
+				return k != null_ptr ? k->sum(p, n) : scalar_search::sum(p, n);
+			}
+
+			static inline T dot(const T *a, const T *b, const size_t n)
+			{
+				const simd::table<T> *k = simd::select<T>();
+				return k != null_ptr ? k->dot(a, b, n) : scalar_search::dot(a, b, n);
+			}
+		};
+    #endif
+
+		/* Unsigned integer of N bytes */
+		template<size_t N> struct lane_of_size{};
+		template<> struct lane_of_size<1>{typedef uint8_t type;};
+		template<> struct lane_of_size<2>{typedef uint16_t type;};
+		template<> struct lane_of_size<4>{typedef uint32_t type;};
+		template<> struct lane_of_size<8>{typedef uint64_t type;};
+
+		/* Reverses [first, last) in place. Trivially relocatable elements of 1, 2, 4 or 8 bytes are
+		 * handled as unsigned lanes and reversed with SIMD shuffles, all others with swaps. */
+		template<class T> inline void reverse_range(T *first, T *last, std::false_type)
+		{
+			std::reverse(first, last);
+		}
+
+		template<class T> inline void reverse_range(T *first, T *last, std::true_type)
+		{
+        #ifdef GT_HAS_SIMD
+			typedef typename lane_of_size<sizeof(T)>::type W;
+			const simd::table<W> *k = simd::select<W>();
+			if(k != null_ptr) return k->reverse(reinterpret_cast<W *>(first), reinterpret_cast<W *>(last));
+        #endif
+			std::reverse(first, last);
+		}
+
+		template<class T> inline void reverse_range(T *first, T *last)
+		{
+			reverse_range(first, last, std::integral_constant<bool, is_trivially_relocatable<T>::value
+					&& (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)>());
+		}
+	} // end of namespace detail
+
+	template<class T, class GrowthPolicy = default_growth, class Allocator = GT::allocator<T> > class iVector:
+		private detail::allocator_holder<Allocator>
+	{
+		private:
+		// Attributes
+			husk_t core;	// important attributes, see class Husk
+			T *objects;		// generic pointer for the dynamic array
+
+			typedef std::allocator_traits<Allocator> alloc_traits;
+			static_assert(std::is_same<typename alloc_traits::pointer, T *>::value, "the Allocator must use plain pointers");
+
+
+		// Private methods
+
+			/* Replaces the content with n elements constructed by make(p, i) in the chunks of policy.
+			 * Types that may throw on a copy are constructed by this thread. */
+			template<class Make, class Policy> inline void rebuild(const size_t n, Make make, const Policy &policy);
+
+			/* Returns true if p points into the live elements */
+			inline bool owns(const T *p) const
+			{
+				return !std::less<const T *>()(p, this->begin()) && std::less<const T *>()(p, this->end());
+			}
+
+			/* Returns storage of the Allocator for n elements, null for n == 0.
+			 * Throws std::bad_alloc if out of memory or if n elements do not fit in a size_t. */
+			inline T *allocate_array(const size_t n);
+
+			/* Returns storage of allocate_array(n) to the Allocator */
+			inline void deallocate_array(T *p, const size_t n);
+
+			/* Set new core settings */
+			inline void setCore(const husk_t &src);
+
+			/* Returns true if the next insertion at the end needs a reallocation */
+			inline bool exhausted(void) const;
+
+			/* Returns the capacity after the next growth step of the GrowthPolicy */
+			inline size_t grown_capacity(const size_t required);
+
+			/* Leaves a moved-from object empty and without storage */
+			inline void release(void);
+
+			/* Releases the storage of self and takes over the storage of rhs, the allocators must be equal */
+			inline void steal(iVector<T, GrowthPolicy, Allocator> &rhs);
+
+			/* See the move assignment, dispatched on propagate_on_container_move_assignment */
+			inline void move_assign(iVector<T, GrowthPolicy, Allocator> &rhs, std::true_type);
+			inline void move_assign(iVector<T, GrowthPolicy, Allocator> &rhs, std::false_type);
+
+			/* Moves the elements to a new array of newCapacity. Trivially relocatable elements are
+			 * grown or shrunk in place if the Allocator can reallocate. Returns false if out of memory. */
+			inline bool reallocate(const size_t newCapacity);
+
+			/* Opens [index, index + count) as unconstructed storage and shifts the tail behind it.
+			 * Reallocates at most once. The size is not changed. Returns a pointer to the gap. */
+			inline T *make_gap(const size_t index, const size_t count);
+
+			/* Inserts [first, last) before position, see insert */
+			template<class InputIterator> inline T *insert_range(const size_t index,
+					InputIterator first, InputIterator last, std::input_iterator_tag);
+			template<class ForwardIterator> inline T *insert_range(const size_t index,
+					ForwardIterator first, ForwardIterator last, std::forward_iterator_tag);
+
+
+			template<class Y, class C> friend class iSnapshotReader; // reads into the storage
+
+		public:
+
+		// Iterator types
+			typedef T *iterator;
+			typedef const T *const_iterator;
+			typedef reverse_iterator_t<T> reverse_iterator;
+			typedef const reverse_iterator_t<T> const_reverse_iterator;
+
+		// Container types
+			typedef T value_type;
+			typedef Allocator allocator_type;
+
+		// Batch edits
+			/* Collects inserts and erases at positions of the current content and applies them
+			 * together in one linear pass, see class patch below. */
+			class patch;
+
+
+		// Constructors
+
+			/* Creates an empty iVector with room for initCapacity elements. Without initCapacity no
+			 * memory is allocated, the first insertion allocates as much as the GrowthPolicy chooses. */
+			inline explicit iVector(const size_t initCapacity = 0, const Allocator &alloc = Allocator()):
+				detail::allocator_holder<Allocator>(alloc), core(0, 0, 0, 0), objects(null_ptr)
+			{	// 1. ascending   2. bearingsCount   3. actualSize   4. actualCapacity
+				if(initCapacity != 0) this->reserve(GrowthPolicy::initial(this->core, initCapacity));
+			}
+
+			/* Creates an empty iVector that takes its storage from alloc. No memory is allocated. */
+			inline explicit iVector(const Allocator &alloc): detail::allocator_holder<Allocator>(alloc), core(0, 0, 0, 0), objects(null_ptr)
+			{	// 1. ascending   2. bearingsCount   3. actualSize   4. actualCapacity
+			}
+
+			/* Creates a iVector of length n, containing n copies of value. */
+			inline explicit iVector(const T &src, const size_t size = 1, const Allocator &alloc = Allocator()):
+				detail::allocator_holder<Allocator>(alloc), core(0, 0, 0, 0)
+			{	// 1. ascending   2. bearingsCount   3. actualSize   4. actualCapacity
+				this->core.actualCapacity = size != 0 ? GrowthPolicy::initial(this->core, size) : 0;
+				this->objects = this->allocate_array(this->core.actualCapacity);
+				try
+				{
+					detail::uninitialized_fill_range(this->allocator_ref(), this->objects, size, src);
+				}
+				catch(...)
+				{
+					this->deallocate_array(this->objects, this->core.actualCapacity);
+					throw;
+				}
+				this->core.actualSize = size;
+			}
+
+			/* The copy ctor Creates a copy of src. The allocator is chosen by
+			 * std::allocator_traits<Allocator>::select_on_container_copy_construction. */
+			inline iVector(const iVector<T, GrowthPolicy, Allocator> &src):
+				detail::allocator_holder<Allocator>(alloc_traits::select_on_container_copy_construction(src.allocator_ref())),
+				core(src.getCore())
+			{
+				if(src.empty()) this->core.actualCapacity = 0;
+				this->objects = this->allocate_array(this->core.actualCapacity);
+				try
+				{
+					detail::uninitialized_copy_range(this->allocator_ref(), src.begin(), src.end(), this->objects);
+				}
+				catch(...)
+				{
+					this->deallocate_array(this->objects, this->core.actualCapacity);
+					throw;
+				}
+			}
+
+			/* Creates a copy of src that takes its storage from alloc. */
+			inline iVector(const iVector<T, GrowthPolicy, Allocator> &src, const Allocator &alloc):
+				detail::allocator_holder<Allocator>(alloc), core(src.getCore())
+			{
+				if(src.empty()) this->core.actualCapacity = 0;
+				this->objects = this->allocate_array(this->core.actualCapacity);
+				try
+				{
+					detail::uninitialized_copy_range(this->allocator_ref(), src.begin(), src.end(), this->objects);
+				}
+				catch(...)
+				{
+					this->deallocate_array(this->objects, this->core.actualCapacity);
+					throw;
+				}
+			}
+
+			/* The move ctor takes over the storage and the allocator of src. src is left empty without storage. */
+			inline iVector(iVector<T, GrowthPolicy, Allocator> &&src) noexcept:
+				detail::allocator_holder<Allocator>(src.allocator_ref()), core(src.getCore()), objects(src.objects)
+			{
+				src.release();
+			}
+
+			/* Takes over the storage of src if alloc equals the allocator of src, otherwise
+			 * moves the elements into storage of alloc. */
+			inline iVector(iVector<T, GrowthPolicy, Allocator> &&src, const Allocator &alloc):
+				detail::allocator_holder<Allocator>(alloc), core(src.getCore()), objects(src.objects)
+			{
+				if(this->allocator_ref() == src.allocator_ref()) src.release();
+				else
+				{
+					if(src.empty()) this->core.actualCapacity = 0;
+					this->objects = this->allocate_array(this->core.actualCapacity);
+					try
+					{
+						detail::uninitialized_copy_range(this->allocator_ref(),
+								std::make_move_iterator(src.begin()), std::make_move_iterator(src.end()), this->objects);
+					}
+					catch(...)
+					{
+						this->deallocate_array(this->objects, this->core.actualCapacity);
+						throw;
+					}
+				}
+			}
+
+			/* Ctor to convert and creates a copy of src. */
+			template<class Y, class P, class A> inline iVector(const iVector<Y, P, A> &src, const Allocator &alloc = Allocator()):
+				detail::allocator_holder<Allocator>(alloc), core(0, 0, 0, 0), objects(null_ptr)
+			{
+				if(is<T, Y>::derived) // Check if Y is a derivation of T
+				{
+					if(!src.empty()) this->reserve(GrowthPolicy::initial(this->core, src.capacity()));
+					try
+					{
+						detail::uninitialized_copy_range(this->allocator_ref(), src.begin(), src.end(), this->objects);
+					}
+					catch(...)
+					{
+						this->deallocate_array(this->objects, this->core.actualCapacity);
+						throw;
+					}
+					this->core.actualSize = src.size();
+				}
+				else
+				{
+                    #ifdef GT_CERR_ACTIVE
+					std::cerr << "IN FUNCTION: template<class Y, class P, class A> inline iVector(const iVector<Y, P, A> &src);" << std::endl;
+					std::cerr << "is<T, Y>::derived == false -> DATATYPE IS NOT COMPATIBLE!" << std::endl;
+                    #endif
+				}
+			}
+
+
+		// Destructor
+			~iVector();
+
+
+		// Methods
+
+			/* Sorts the elements in the range [first,last) into ascending order.
+			 * The elements are compared using operator< for the first version, and comp for the second.
+			 * Equivalent elements are not guaranteed to keep their original relative order (see stable_sort). */
+			inline void sort(void){std::sort(this->begin(), this->end());}
+
+			/* Sorts into descending order if descending is set, without a mirror pass. */
+			inline void sort(const bool descending){iSpan<T>(this->objects, this->size()).sort(descending);}
+
+			/* Sorts into descending order. */
+			inline void sort_reverse(void){this->sort(true);}
+
+			/* Sorts with a sort policy, like GT::parallel_merge_sort or GT::parallel_radix_sort of
+			 * iparallel.h. fn goes to the policy: the comparator of a comparison sort, the key
+			 * projection of a radix sort. */
+			template<class Policy> inline typename std::enable_if<std::is_class<Policy>::value>::type sort(const Policy &policy)
+			{
+				policy.sort(this->begin(), this->end());
+			}
+			template<class Policy, class Fn> inline void sort(const Policy &policy, Fn fn){policy.sort(this->begin(), this->end(), fn);}
+
+			/* Sorts into ascending order, equivalent elements keep their relative order. */
+			inline void stable_sort(void){std::stable_sort(this->begin(), this->end());}
+			template<class Policy> inline void stable_sort(const Policy &policy){policy.stable_sort(this->begin(), this->end());}
+			template<class Policy, class Fn> inline void stable_sort(const Policy &policy, Fn fn){policy.stable_sort(this->begin(), this->end(), fn);}
+
+			/* Moves the element a full sort would put at position k there, with no greater element
+			 * before and no smaller one behind it. Introselect, linear on average. */
+			inline void nth_element(const size_t k){this->nth_element(k, std::less<T>());}
+			template<class Compare> inline void nth_element(const size_t k, Compare comp){iSpan<T>(this->objects, this->size()).nth_element(k, comp);}
+
+			/* Sorts the k first elements of a full sort into [0, k), the rest is left in no particular
+			 * order. Heap select, O(n log k). */
+			inline void partial_sort(const size_t k){this->partial_sort(k, std::less<T>());}
+			template<class Compare> inline void partial_sort(const size_t k, Compare comp){iSpan<T>(this->objects, this->size()).partial_sort(k, comp);}
+
+			/* Returns the k first elements of a sort by comp in order (the k smallest for std::less,
+			 * the k largest for std::greater) and leaves self unchanged. A small k keeps a heap of k
+			 * elements in one pass, linear for k << n. The third version searches the chunks of an
+			 * execution policy like GT::parallel of iparallel.h on its threads. */
+			inline iVector<T, GrowthPolicy, Allocator> top_k(const size_t k) const{return this->top_k(k, std::less<T>());}
+			template<class Compare> inline iVector<T, GrowthPolicy, Allocator> top_k(const size_t k, Compare comp) const;
+			template<class Compare, class Policy> inline iVector<T, GrowthPolicy, Allocator> top_k(const size_t k, Compare comp, const Policy &policy) const;
+
+			/* Bulk algorithms. The versions with an execution policy like GT::parallel of iparallel.h
+			 * run on its threads in chunks that start on cache lines, so the functions are called from
+			 * several threads at once. */
+
+			/* Assigns x to every element. */
+			inline void fill(const T &x){iSpan<T>(this->objects, this->size()).fill(x);}
+			template<class Policy> inline typename std::enable_if<std::is_class<Policy>::value>::type fill(const T &x, const Policy &policy)
+			{
+				iSpan<T>(this->objects, this->size()).fill(x, policy);
+			}
+
+			/* Replaces the content with n copies of x, which may be an element of self. With a policy
+			 * new storage is first touched by its threads, so the pages are placed near them. */
+			inline void fill(const size_t n, const T &x)
+			{
+				if(this->owns(&x))
+				{
+					const T item(x);
+					this->fill(n, item);
+					return;
+				}
+				this->clear();
+				this->insert(this->end(), n, x);
+			}
+			template<class Policy> inline void fill(const size_t n, const T &x, const Policy &policy)
+			{
+				if(this->owns(&x))
+				{
+					const T item(x);
+					this->fill(n, item, policy);
+					return;
+				}
+				this->rebuild(n, [&](T *p, size_t){alloc_traits::construct(this->allocator_ref(), p, x);}, policy);
+			}
+
+			/* Replaces the content with copies of the n elements at first. */
+			inline void copy_from(const T *first, const size_t n)
+			{
+				iVector<T, GrowthPolicy, Allocator> copy(0, this->get_allocator());
+				iVector<T, GrowthPolicy, Allocator> &target = this->owns(first) ? copy : *this;
+				target.clear();
+				target.insert(target.end(), first, first + n);
+				if(&target == &copy) this->swap(copy);
+			}
+			template<class Policy> inline void copy_from(const T *first, const size_t n, const Policy &policy)
+			{
+				iVector<T, GrowthPolicy, Allocator> copy(0, this->get_allocator());
+				iVector<T, GrowthPolicy, Allocator> &target = this->owns(first) ? copy : *this;
+				target.rebuild(n, [&](T *p, size_t i){alloc_traits::construct(target.allocator_ref(), p, first[i]);}, policy);
+				if(&target == &copy) this->swap(copy);
+			}
+			template<class P, class A, class Policy> inline void copy_from(const iVector<T, P, A> &src, const Policy &policy)
+			{
+				this->copy_from(src.begin(), src.size(), policy);
+			}
+			inline void copy_from(const iSpan<const T> &src){this->copy_from(src.data(), src.size());}
+			template<class Policy> inline void copy_from(const iSpan<const T> &src, const Policy &policy)
+			{
+				this->copy_from(src.data(), src.size(), policy);
+			}
+
+			/* Replaces every element x with fn(x). */
+			template<class Fn> inline void transform(Fn fn){iSpan<T>(this->objects, this->size()).transform(fn);}
+			template<class Fn, class Policy> inline void transform(Fn fn, const Policy &policy){iSpan<T>(this->objects, this->size()).transform(fn, policy);}
+
+			/* Calls fn(x) for every element. */
+			template<class Fn> inline void for_each(Fn fn){iSpan<T>(this->objects, this->size()).for_each(fn);}
+			template<class Fn, class Policy> inline void for_each(Fn fn, const Policy &policy){iSpan<T>(this->objects, this->size()).for_each(fn, policy);}
+
+			/* Returns init combined with all elements by op, from left to right. The parallel version
+			 * combines the chunks in order, so op has to be associative but not commutative. */
+			template<class Op> inline T reduce(T init, Op op) const{return iSpan<const T>(this->objects, this->size()).reduce(init, op);}
+			template<class Op, class Policy> inline T reduce(T init, Op op, const Policy &policy) const
+			{
+				return iSpan<const T>(this->objects, this->size()).reduce(init, op, policy);
+			}
+
+			/* Returns a pointer to the first element equal to x, end() if there is none.
+			 * For arithmetic T the search members (find, count, contains, min_element, max_element,
+			 * sum, dot) run on SSE2, AVX2 or AVX-512 kernels, whichever the CPU supports. */
+			inline iterator find(const T &x){return this->objects + detail::search<T>::find(this->objects, this->size(), x);}
+			inline const_iterator find(const T &x) const{return this->objects + detail::search<T>::find(this->objects, this->size(), x);}
+
+			/* Returns the number of elements equal to x. */
+			inline size_t count(const T &x) const{return detail::search<T>::count(this->objects, this->size(), x);}
+
+			/* Returns true if an element is equal to x. */
+			inline bool contains(const T &x) const{return this->find(x) != this->end();}
+
+			/* Returns a pointer to the first smallest element, end() if self is empty.
+			 * Like std::min_element, a NaN in the first element is the result. */
+			inline iterator min_element(void){return this->objects + detail::search<T>::min_element(this->objects, this->size());}
+			inline const_iterator min_element(void) const{return this->objects + detail::search<T>::min_element(this->objects, this->size());}
+
+			/* Returns a pointer to the first largest element, end() if self is empty. */
+			inline iterator max_element(void){return this->objects + detail::search<T>::max_element(this->objects, this->size());}
+			inline const_iterator max_element(void) const{return this->objects + detail::search<T>::max_element(this->objects, this->size());}
+
+			/* Returns the sum of all elements, T() if self is empty. The kernels add in several
+			 * lanes, so a floating point sum may round differently than a loop from left to right. */
+			inline T sum(void) const{return detail::search<T>::sum(this->objects, this->size());}
+
+			/* Returns the sum of the products of the elements of self and rhs, up to the shorter size. */
+			template<class P, class A> inline T dot(const iVector<T, P, A> &rhs) const
+			{
+				return detail::search<T>::dot(this->objects, rhs.begin(), this->size() < rhs.size() ? this->size() : rhs.size());
+			}
+			inline T dot(const iSpan<const T> &rhs) const
+			{
+				return detail::search<T>::dot(this->objects, rhs.data(), this->size() < rhs.size() ? this->size() : rhs.size());
+			}
+
+			/* Returns a view of count elements from index first, clamped to the size. Nothing is
+			 * copied, the span is valid until self reallocates. Slices of one iVector can be handed
+			 * to threads, see class iSpan. */
+			inline iSpan<T> slice(const size_t first, const size_t count){return iSpan<T>(this->objects, this->size()).subspan(first, count);}
+			inline iSpan<const T> slice(const size_t first, const size_t count) const{return iSpan<const T>(this->objects, this->size()).subspan(first, count);}
+
+			/* return clone of this object */
+			inline iVector<T, GrowthPolicy, Allocator> *clone(void){return GT_ALLOCATER_T iVector<T, GrowthPolicy, Allocator>(*this);}
+
+			/* Replaces elements in *this with n copies of t. The function invalidates all
+			 * iterators and references to elements in *this. */
+			inline void assign(const iVector<T, GrowthPolicy, Allocator> &src);
+
+			/* Returns a constant reference to the first element. */
+			inline const T &front(void) const;
+
+			/* Returns a reference to the first element. */
+			inline T &front(void);
+
+			/* Inserts a copy of x to the begin of self. Shifts all elements, see iDequeVector for a queue. */
+			inline void push_front(const T &x);
+
+			/* Constructs an element in place before position, using args as the arguments for its constructor.
+			 * Returns an iterator that points to the new element. */
+			template<class... Args> inline iterator emplace(const_iterator position, Args&&... args);
+
+			/* Inserts a copy of new_item at the index position. */
+			inline void insert(const T new_item, const size_t position = 0);
+
+			/* Inserts x before position. The tail is shifted in place, at most one reallocation.
+			 * Returns an iterator that points to the inserted element. */
+			inline iterator insert(const_iterator position, const T &x);
+			inline iterator insert(const_iterator position, T &&x);
+
+			/* Inserts n copies of x before position. Returns an iterator that points to the first inserted element. */
+			inline iterator insert(const_iterator position, const size_t n, const T &x);
+
+			/* Inserts copies of the elements in the range [first, last) before position.
+			 * Returns an iterator that points to the first inserted element. */
+			template<class InputIterator, class = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+			inline iterator insert(const_iterator position, InputIterator first, InputIterator last);
+
+			/* Deletes the iVector element from the index position begin and deletes any desired number of items. */
+			inline void erase(const size_t begin, const size_t pieces = 1);
+			inline void erase(const_iterator it, const size_t pieces = 1)
+			{
+				if(pieces > 0)
+					if(this->size() != 0 && it >= this->begin() && it < this->end())
+						this->erase(it, it + ((size_t)(this->end() - it) < pieces ? (size_t)(this->end() - it) : pieces));
+			}
+
+			/* Deletes the elements in [first, last) and shifts the tail in place.
+			 * Returns an iterator that points to the element behind the erased ones. */
+			inline iterator erase(const_iterator first, const_iterator last);
+
+			/* Alters the size of self. If the new size (sz) is greater than the current size,
+			 * then sz-size() instances of the default value of type T are inserted at the end of the iVector.
+			 * If the new size is smaller than the current capacity, then the iVector is truncated by erasing
+			 * size()-sz elements off the end. If sz is equal to capacity then no action is taken. */
+			inline void resize(const size_t newSize);
+
+			/* Increases the capacity of self in anticipation of adding new elements.
+			 * reserve itself does not add any new elements. After a call to reserve,
+			 * capacity() is greater than or equal to n and subsequent insertions will
+			 * not cause a reallocation until the size of the iVector exceeds n. Reallocation
+			 * does not occur if n is less than capacity(). If reallocation does occur,
+			 * then all iterators and references pointing to elements in the iVector are invalidated.
+			 * reserve takes at most linear time in the size of self. reserve throws a length_error
+			 * exception if n is greater than max_size(). */
+			inline void reserve(const size_t newCapacity);
+
+			/* Returns true if the size is zero. */
+			inline bool empty(void) const;
+
+			/* Returns the number of elements. */
+			inline size_t size(void) const;
+
+			/* Returns the size of the allocated storage, as the number of elements that can be stored. */
+			inline size_t capacity(void) const;
+
+			/* Inserts a copy of x to the end of self. */
+			inline void push_back(const T &x);
+
+			/* Moves x to the end of self. */
+			inline void push_back(T &&x);
+
+			/* Constructs an element in place at the end of self, using args as the arguments for its constructor.
+			 * Returns a reference to the new element. */
+			template<class... Args> inline T &emplace_back(Args&&... args);
+
+			/* Removes the first element of self. Shifts all elements, see iDequeVector for a queue. */
+			inline void pop_front(void);
+
+			/* Removes the last element of self. The capacity is only reduced if the GrowthPolicy shrinks. */
+			inline void pop_back(void);
+
+			/* Requests the removal of unused capacity. */
+			inline void shrink_to_fit(void);
+
+			/* Returns a reference to the last element. */
+			inline T &back(void);
+
+			/* Returns a constant reference to the last element. */
+			inline const T &back(void) const;
+
+			/* Returns a reference to element n of self. The result can be used as an lvalue.
+			 * The index n must be between 0 and the size less one. */
+			inline T &at(const size_t index);
+
+			/* Returns a constant reference to element n of self.
+			 * The index n must be between 0 and the size less one. */
+			inline const T &at(const size_t index) const;
+
+			/* Deletes all elements from the iVector. The capacity is kept unless the GrowthPolicy
+			 * shrinks (see hysteresis_shrink), shrink_to_fit releases the memory. */
+			inline void clear(void);
+
+			/* Exchanges self with src, by swapping the storage. The allocators are swapped
+			 * if std::allocator_traits<Allocator>::propagate_on_container_swap is set. */
+			inline void swap(iVector<T, GrowthPolicy, Allocator> &src);
+
+			/* Return actual core */
+			inline husk_t getCore(void) const;
+
+			/* Returns a copy of the allocator. */
+			inline Allocator get_allocator(void) const{return this->allocator_ref();}
+
+			/* Changes the Direction of all elements, in place. */
+			inline void mirror(void){iSpan<T>(this->objects, this->size()).mirror();}
+
+			/* Reverses the elements in [first, last) in place. */
+			inline void reverse(iterator first, iterator last){detail::reverse_range(first, last);}
+
+			/* Rotates the elements in place, so that the element at position k becomes the first.
+			 * k is taken modulo size(). */
+			inline void rotate(const size_t k){iSpan<T>(this->objects, this->size()).rotate(k);}
+
+			/* Returns an empty patch for self. Apply it with patch::commit(). */
+			inline patch edit(void){return patch(*this);}
+
+			/* Writes self as a binary snapshot, see detail::snapshot_header. Raw elements (see codec)
+			 * are written as one block, others one by one with coder. Returns false on a stream error. */
+			template<class Codec = GT::codec<T> > inline bool save(std::ostream &os, const Codec &coder = Codec()) const;
+
+			/* Replaces the content with a snapshot of save or iSnapshotWriter. The storage is reserved
+			 * once from the header and raw elements are read as one block. Returns false and leaves
+			 * self empty if the snapshot is broken or was written for another datatype, also if the
+			 * codec throws. */
+			template<class Codec = GT::codec<T> > inline bool load(std::istream &is, const Codec &coder = Codec());
+
+        #ifdef GT_HAS_UNISTD
+			/* save and load on a POSIX file descriptor, large blocks go straight to write and read. */
+			template<class Codec = GT::codec<T> > inline bool save(const int fd, const Codec &coder = Codec()) const
+			{
+				detail::fd_streambuf buffer(fd);
+				std::ostream os(&buffer);
+				return this->save(os, coder) && buffer.pubsync() == 0;
+			}
+
+			template<class Codec = GT::codec<T> > inline bool load(const int fd, const Codec &coder = Codec())
+			{
+				detail::fd_streambuf buffer(fd);
+				std::istream is(&buffer);
+				return this->load(is, coder);
+			}
+        #endif
+
+
+		// Operators
+
+			/* Caution: Note the size of the datatypes! */
+			/* First check if Y are a derivation of T. Is the datatype correct cast the iVector obj in the basic Y* datatype */
 			template<class Y> inline operator Y*() const
 			{
-				if(is<T, Y>::derived) // Check if Y is a derivation of T
-					return (Y *)(this->objects);
-				else
-				{
-                    #ifdef GT_CERR_ACTIVE
-					std::cerr << "IN FUNCTION: template<class Y> inline operator Y*() const;" << std::endl;
-					std::cerr << "is<T, Y>::derived == false -> DATATYPE IS NOT COMPATIBLE!" << std::endl;
-                    #endif
-					return null_ptr;
-				}
+				if(is<T, Y>::derived) // Check if Y is a derivation of T
+					return (Y *)(this->objects);
+				else
+				{
+                    #ifdef GT_CERR_ACTIVE
+					std::cerr << "IN FUNCTION: template<class Y> inline operator Y*() const;" << std::endl;
+					std::cerr << "is<T, Y>::derived == false -> DATATYPE IS NOT COMPATIBLE!" << std::endl;
+                    #endif
+					return null_ptr;
+				}
+			}
+
+			/* cast the iVector obj in the basic T* datatype */
+			inline operator T*() const
+			{
+				return this->objects;
+			}
+
+			/* The assignment operator replaces the elements of self with a copy of each element in rhs.
+			 * The copy is made first, so self is unchanged if it throws. Returns a reference to self.
+			 * The allocator of rhs is copied if
+			 * std::allocator_traits<Allocator>::propagate_on_container_copy_assignment is set. */
+			inline iVector<T, GrowthPolicy, Allocator> &operator=(const iVector<T, GrowthPolicy, Allocator> &rhs);
+
+			/* The move assignment releases all elements in self and takes over the storage of rhs.
+			 * If the allocators differ and propagate_on_container_move_assignment is not set,
+			 * the elements are moved one by one into the storage of self instead. */
+			inline iVector<T, GrowthPolicy, Allocator> &operator=(iVector<T, GrowthPolicy, Allocator> &&rhs)
+					noexcept(alloc_traits::propagate_on_container_move_assignment::value);
+
+			/* See push_back */
+			inline iVector<T, GrowthPolicy, Allocator> &operator+=(T &rhs)
+			{
+				this->push_back(rhs);
+				return *this;
+			}
+
+			/* First check if Y are a derivation of T. Is the datatype correct make copy of rhs */
+			template<class Y, class P, class A> inline iVector<T, GrowthPolicy, Allocator> &operator=(const iVector<Y, P, A> &rhs)
+			{
+				if(static_cast<const void *>(this) == static_cast<const void *>(&rhs)) return *this;
+				if(is<T, Y>::derived) // Check if Y is a derivation of T
+				{
+					iVector<T, GrowthPolicy, Allocator> copy(rhs, this->get_allocator());
+					this->steal(copy);
+				}
+				else
+				{
+                    #ifdef GT_CERR_ACTIVE
+					std::cerr << "IN FUNCTION: template<class Y, class P, class A> inline iVector<T, GrowthPolicy, Allocator> &operator=(const iVector<Y, P, A> &rhs);" << std::endl;
+					std::cerr << "is<T, Y>::derived == false -> DATATYPE IS NOT COMPATIBLE!" << std::endl;
+                    #endif
+
+				}
+				return *this;
+			}
+
+			/* Returns a reference to element n of self. The result can be used as an lvalue.
+			 * The index n must be between 0 and the size less one. */
+			inline T &operator[](const size_t index);
+
+			/* Returns a constant reference to element n of self.
+			 * The index n must be between 0 and the size less one. */
+			inline const T &operator[](const size_t index) const;
+
+
+		// Iterators
+
+			/* Returns a random access const_reverse_iterator that points to the past-the-end value. */
+			inline const_reverse_iterator rbegin(void) const{return &this->operator[](this->size() - 1);}
+
+			/* Returns a random access const_reverse_iterator that points to the first element. */
+			inline const_reverse_iterator rend(void) const
+			{
+				const_reverse_iterator src(&(*(this->objects - 1)));
+				return src;
+			}
+
+			/* Returns a random access iterator that points to the first element. */
+			inline iterator begin(void){return this->objects;}
+
+			/* Returns a random access const_iterator that points to the first element. */
+			inline const_iterator begin(void) const{return this->objects;}
+
+			/* Returns a random access iterator that points to the past-the-end value. */
+			inline iterator end(void){return this->objects + this->size();}
+
+			/* Returns a random access const_iterator that points to the past-the-end value. */
+			inline const_iterator end(void) const{return this->objects + this->size();}
+
+			/* Returns a random access reverse_iterator that points to the past-the-end value. */
+			inline reverse_iterator rbegin(void)
+			{
+				reverse_iterator src(&(*(this->objects + this->size() - 1)));
+				return src;
+			}
+
+			/* Returns a random access reverse_iterator that points to the first element. */
+			inline reverse_iterator rend(void)
+			{
+				reverse_iterator src(&(*(this->objects - 1)));
+				return src;
+			}
+	};
+
+	/* Class: iVector<T, GrowthPolicy, Allocator>::patch:
+		A patch records inserts and erases at positions of the content the iVector has
+		when the patch is committed. Positions are never shifted by other edits of the
+		same patch: insert(3, x) places x before the old element 3, erase(3) removes the old
+		element 3. Inserts at the same position keep their order. Positions past the size are
+		taken as the size: such an insert appends, such an erase removes only what exists.
+		commit() moves every surviving element once, in place if the capacity suffices,
+		otherwise into a single new array. Applying k edits costs O(size + k log k) instead of
+		O(k * size).
+	*/
+	template<class T, class GrowthPolicy, class Allocator> class iVector<T, GrowthPolicy, Allocator>::patch
+	{
+		private:
+		// Attributes
+			struct run{size_t source, count, target;};	// survivors moved by one offset
+
+			iVector<T, GrowthPolicy, Allocator> *target;			// the patched iVector
+			iVector<T, GrowthPolicy, Allocator> values;	// inserted values in recording order
+			iVector<std::pair<size_t, size_t> > inserts;	// position, index in values
+			iVector<std::pair<size_t, size_t> > erasures;	// position, pieces
+
+		public:
+		// Constructors
+			inline explicit patch(iVector<T, GrowthPolicy, Allocator> &target): target(&target), values(target.allocator_ref()){}
+
+		// Methods
+			/* Records an insert of x before the element at position. */
+			inline void insert(const size_t position, const T &x)
+			{
+				this->inserts.push_back(std::make_pair(position, this->values.size()));
+				this->values.push_back(x);
+			}
+
+			inline void insert(const size_t position, T &&x)
+			{
+				this->inserts.push_back(std::make_pair(position, this->values.size()));
+				this->values.push_back(std::move(x));
+			}
+
+			/* Records the deletion of pieces elements from position. Overlapping erases are merged. */
+			inline void erase(const size_t position, const size_t pieces = 1)
+			{
+				if(pieces > 0) this->erasures.push_back(std::make_pair(position, pieces));
+			}
+
+			/* Returns the number of recorded edits. */
+			inline size_t size(void) const{return this->inserts.size() + this->erasures.size();}
+
+			/* Returns true if no edit is recorded. */
+			inline bool empty(void) const{return this->size() == 0;}
+
+			/* Discards all recorded edits. */
+			inline void clear(void)
+			{
+				this->values.clear(); this->inserts.clear(); this->erasures.clear();
+			}
+
+			/* Applies all recorded edits to the iVector and clears the patch. If the new array
+			 * cannot be allocated, std::bad_alloc is thrown and the iVector is unchanged. */
+			inline void commit(void);
+	};
+
+	template<class T, class GrowthPolicy, class Allocator> void iVector<T, GrowthPolicy, Allocator>::patch::commit(void)
+	{
+		iVector<T, GrowthPolicy, Allocator> &self = *this->target;
+		const size_t oldSize = self.size();
+		std::sort(this->inserts.begin(), this->inserts.end());
+		std::sort(this->erasures.begin(), this->erasures.end());
+
+		// 1. plan: split the survivors into runs, the erased elements are the gaps between them
+		iVector<run> runs(this->erasures.size() + this->inserts.size() + 1);
+		iVector<size_t> slots; slots.reserve(this->inserts.size());
+		size_t source = 0, dest = 0;
+		const std::pair<size_t, size_t> *ins = this->inserts.begin(), *era = this->erasures.begin();
+		while(ins != this->inserts.end() || era != this->erasures.end())
+		{
+			const bool isInsert = era == this->erasures.end() || (ins != this->inserts.end() && ins->first <= era->first);
+			size_t from = std::min(isInsert ? ins->first : era->first, oldSize);
+			if(from < source) from = source; // overlaps an erase before
+			if(from > source)
+			{
+				const run r = {source, from - source, dest};
+				runs.push_back(r);
+				dest += from - source; source = from;
+			}
+			if(isInsert)
+			{
+				slots.push_back(dest++); ++ins;
+			}
+			else
+			{
+				const size_t first = std::min(era->first, oldSize);
+				const size_t to = first + std::min(era->second, oldSize - first);
+				if(to > source) source = to;
+				++era;
+			}
+		}
+		if(oldSize > source)
+		{
+			const run r = {source, oldSize - source, dest};
+			runs.push_back(r);
+			dest += oldSize - source;
+		}
+
+		// 2. allocate before anything is destroyed, then destroy the erased elements
+		T *newArray = null_ptr;
+		size_t newCapacity = 0;
+		if(dest > self.capacity())
+		{
+			newCapacity = self.grown_capacity(dest);
+			newArray = self.allocate_array(newCapacity);
+		}
+		size_t alive = 0;
+		for(const run *r = runs.begin(); r != runs.end(); alive = r->source + r->count, ++r)
+			if(r->source > alive) detail::destroy_range(self.allocator_ref(), self.objects + alive, self.objects + r->source);
+		if(oldSize > alive) detail::destroy_range(self.allocator_ref(), self.objects + alive, self.objects + oldSize);
+
+		// 3. move the runs: into the new array, or in place. In place the targets are increasing like
+		//    the sources, so runs moving down go first from the front, runs moving up from the back.
+		if(newArray != null_ptr)
+		{
+			for(const run *r = runs.begin(); r != runs.end(); ++r)
+				detail::relocate_range(self.allocator_ref(), self.objects + r->source, self.objects + r->source + r->count, newArray + r->target);
+			self.deallocate_array(self.objects, self.core.actualCapacity);
+			self.objects = newArray;
+			self.core.actualCapacity = newCapacity;
+		}
+		else
+		{
+			for(const run *r = runs.begin(); r != runs.end(); ++r)
+				if(r->target < r->source)
+					detail::relocate_overlapping(self.allocator_ref(), self.objects + r->source, self.objects + r->source + r->count, self.objects + r->target);
+			for(size_t i = runs.size(); i-- > 0; )
+				if(runs[i].target > runs[i].source)
+					detail::relocate_overlapping(self.allocator_ref(), self.objects + runs[i].source,
+							self.objects + runs[i].source + runs[i].count, self.objects + runs[i].target);
+		}
+
+		// 4. fill the gaps with the inserted values
+		for(size_t i=0; i<slots.size(); i++)
+			alloc_traits::construct(self.allocator_ref(), self.objects + slots[i], std::move(this->values[this->inserts[i].second]));
+		self.core.actualSize = dest;
+		this->clear();
+	}
+
+	namespace detail
+	{
+		/* Appends the k first elements of [first, last) sorted by comp to the empty out */
+		template<class T, class Compare, class Out> inline void select_top(const T *first, const T *last, const size_t k, Compare &comp, Out &out)
+		{
+			const size_t n = size_t(last - first);
+			if(k == 0) return;
+			if(k >= n / 8)
+			{	// large k: select in a copy
+				out.reserve(n);
+				for(; first != last; ++first) out.push_back(*first);
+				if(k < n)
+				{
+					std::nth_element(out.begin(), out.begin() + k, out.end(), comp);
+					out.erase(k, n - k);
+				}
+				std::sort(out.begin(), out.end(), comp);
+				return;
+			}
+			out.reserve(k);
+			for(; out.size() < k; ++first) out.push_back(*first);
+			std::make_heap(out.begin(), out.end(), comp);	// the front is the last one kept
+			for(; first != last; ++first)
+				if(comp(*first, out.front()))
+				{
+					std::pop_heap(out.begin(), out.end(), comp);
+					out.back() = *first;
+					std::push_heap(out.begin(), out.end(), comp);
+				}
+			std::sort_heap(out.begin(), out.end(), comp);
+		}
+
+		/* select_top of the n elements at first on the chunks of an execution policy: every chunk
+		 * selects its k first elements, and the k first of these candidates go to out. */
+		template<class T, class Compare, class Policy, class Out>
+		inline void select_top(const T *first, const size_t n, const size_t k, Compare comp, const Policy &policy, Out &out)
+		{
+			const size_t chunks = policy.chunks(n);
+			if(chunks < 2 || k == 0)
+			{
+				select_top(first, first + n, k, comp, out);
+				return;
+			}
+
+			iVector<Out> parts(chunks);
+			for(size_t c=0; c<chunks; c++) parts.push_back(Out(0, out.get_allocator()));
+			policy.run(n, [&](size_t c, size_t begin, size_t end)
+			{
+				Compare less = comp;
+				select_top(first + begin, first + end, k, less, parts[c]);
+			});
+
+			Out candidates(0, out.get_allocator());
+			for(size_t c=0; c<chunks; c++)
+				for(size_t i=0; i<parts[c].size(); i++) candidates.push_back(std::move(parts[c][i]));
+			select_top(candidates.begin(), candidates.end(), k, comp, out);
+		}
+	} // end of namespace detail
+
+	/* Class: iSpan<T>:
+		A view of n elements of an array that it does not own, e.g. iVector::slice(first, count).
+		Copying a span copies two words and no elements, so a vector can be split into spans for
+		threads or kernels without an allocation. iSpan<const T> only reads. A span is valid as
+		long as the viewed storage is neither freed nor reallocated. The algorithm members are
+		the ones of iVector, working on the viewed elements only; iVector runs its own through
+		a span of all its elements.
+	*/
+	template<class T> class iSpan
+	{
+		public:
+		// Container types
+			typedef typename std::remove_const<T>::type value_type;
+			typedef T element_type;
+
+		// Iterator types
+			typedef T *iterator;
+			typedef const value_type *const_iterator;
+
+		private:
+		// Attributes
+			T *objects;
+			size_t length;
+
+		public:
+
+		// Constructors
+
+			/* Creates an empty span */
+			inline iSpan(void): objects(null_ptr), length(0){}
+
+			/* Views the n elements at first */
+			inline iSpan(T *first, const size_t n): objects(first), length(n){}
+
+			/* Views all elements of src. An iSpan<const T> also views a const iVector. */
+			template<class P, class A> inline iSpan(iVector<value_type, P, A> &src): objects(src.begin()), length(src.size()){}
+			template<class P, class A, class Y = T, class = typename std::enable_if<std::is_const<Y>::value>::type>
+			inline iSpan(const iVector<value_type, P, A> &src): objects(src.begin()), length(src.size()){}
+
+			/* An iSpan<T> converts to an iSpan<const T> */
+			template<class Y, class = typename std::enable_if<std::is_const<T>::value && std::is_same<Y, value_type>::value>::type>
+			inline iSpan(const iSpan<Y> &src): objects(src.data()), length(src.size()){}
+
+		// Operators
+			inline T &operator[](const size_t index) const{return this->objects[index];}
+
+		// Methods
+			inline size_t size(void) const{return this->length;}
+			inline bool empty(void) const{return this->length == 0;}
+			inline T *data(void) const{return this->objects;}
+			inline T &front(void) const{return this->objects[0];}
+			inline T &back(void) const{return this->objects[this->length - 1];}
+
+			/* Returns the view of count elements from offset, clamped to the size of self */
+			inline iSpan<T> subspan(size_t offset, size_t count = size_t(-1)) const
+			{
+				if(offset > this->length) offset = this->length;
+				if(count > this->length - offset) count = this->length - offset;
+				return iSpan<T>(this->objects + offset, count);
 			}
 
-			/* cast the iVector obj in the basic T* datatype */
-			inline operator T*() const
+			/* Returns the view of the first (last) n elements, at most all */
+			inline iSpan<T> first(const size_t n) const{return this->subspan(0, n);}
+			inline iSpan<T> last(const size_t n) const{return this->subspan(n < this->length ? this->length - n : 0);}
+
+			/* Sorting, see iVector::sort and iVector::stable_sort. */
+			inline void sort(void) const{std::sort(this->begin(), this->end());}
+			template<class Policy> inline typename std::enable_if<std::is_class<Policy>::value>::type sort(const Policy &policy) const
 			{
-				return this->objects;
+				policy.sort(this->begin(), this->end());
+			}
+			template<class Policy, class Fn> inline void sort(const Policy &policy, Fn fn) const{policy.sort(this->begin(), this->end(), fn);}
+			inline void stable_sort(void) const{std::stable_sort(this->begin(), this->end());}
+			template<class Policy> inline void stable_sort(const Policy &policy) const{policy.stable_sort(this->begin(), this->end());}
+			template<class Policy, class Fn> inline void stable_sort(const Policy &policy, Fn fn) const{policy.stable_sort(this->begin(), this->end(), fn);}
+			inline void sort(const bool descending) const
+			{
+				if(descending) std::sort(this->begin(), this->end(), [](const value_type &a, const value_type &b){return b < a;});
+				else this->sort();
+			}
+			inline void sort_reverse(void) const{this->sort(true);}
+
+			/* Selection, see iVector::nth_element, partial_sort and top_k. top_k returns a new iVector. */
+			inline void nth_element(const size_t k) const{this->nth_element(k, std::less<value_type>());}
+			template<class Compare> inline void nth_element(const size_t k, Compare comp) const
+			{
+				if(k < this->length) std::nth_element(this->begin(), this->begin() + k, this->end(), comp);
+			}
+			inline void partial_sort(const size_t k) const{this->partial_sort(k, std::less<value_type>());}
+			template<class Compare> inline void partial_sort(const size_t k, Compare comp) const
+			{
+				std::partial_sort(this->begin(), this->begin() + (k < this->length ? k : this->length), this->end(), comp);
+			}
+			inline iVector<value_type> top_k(const size_t k) const{return this->top_k(k, std::less<value_type>());}
+			template<class Compare> inline iVector<value_type> top_k(const size_t k, Compare comp) const
+			{
+				iVector<value_type> out;
+				detail::select_top(this->objects, this->objects + this->length, k, comp, out);
+				return out;
+			}
+			template<class Compare, class Policy> inline iVector<value_type> top_k(const size_t k, Compare comp, const Policy &policy) const
+			{
+				iVector<value_type> out;
+				detail::select_top(this->objects, this->length, k, comp, policy, out);
+				return out;
 			}
 
-			/* The assignment operator erases all elements in self then inserts into self a copy of each
-			 * element in x. Returns a reference to self. */
-			inline iVector<T> &operator=(const iVector<T> &rhs);
+			/* Reordering in place, see iVector::mirror, reverse and rotate. */
+			inline void mirror(void) const{detail::reverse_range(this->begin(), this->end());}
+			inline void reverse(iterator first, iterator last) const{detail::reverse_range(first, last);}
+			inline void rotate(const size_t k) const;
 
-			/* See push_back */
-			inline iVector<T> &operator+=(T &rhs)
+			/* Bulk algorithms, see iVector::fill, transform, for_each and reduce. */
+			inline void fill(const value_type &x) const{std::fill(this->begin(), this->end(), x);}
+			template<class Policy> inline typename std::enable_if<std::is_class<Policy>::value>::type fill(const value_type &x, const Policy &policy) const
 			{
-				this->push_back(rhs);
-				return *this;
+				policy.run(this->objects, this->length, [&](size_t, size_t begin, size_t end){std::fill(this->objects + begin, this->objects + end, x);});
 			}
 
-			/* First check if Y are a derivation of T. Is the datatype correct make copy of rhs */
-			template<class Y> inline iVector<T> &operator=(iVector<Y> &rhs)
+			template<class Fn> inline void transform(Fn fn) const{for(iterator i = this->begin(); i != this->end(); ++i) *i = fn(*i);}
+			template<class Fn, class Policy> inline void transform(Fn fn, const Policy &policy) const
 			{
-				if(is<T, Y>::derived) // Check if Y is a derivation of T
-				{
-					delete[] this->objects;
-					this->setCore(rhs.getCore());
-					this->core.actualSize = 0;
-					this->objects = GT_ALLOCATER_T T[rhs.capacity()];
-					iterator i = this->begin();
-					for(const Y *it = rhs.begin(); it != rhs.end(); it++, i++) *i = *it;
-					this->setCore(rhs.getCore());
-				}
-				else
-				{
-                    #ifdef GT_CERR_ACTIVE
-					std::cerr << "IN FUNCTION: template<class Y> inline iVector<T> &operator=(iVector<Y> &rhs);" << std::endl;
-					std::cerr << "is<T, Y>::derived == false -> DATATYPE IS NOT COMPATIBLE!" << std::endl;
-                    #endif
+				policy.run(this->objects, this->length, [&](size_t, size_t begin, size_t end){for(size_t i=begin; i<end; i++) this->objects[i] = fn(this->objects[i]);});
+			}
 
-				}
-				return *this;
+			template<class Fn> inline void for_each(Fn fn) const{for(iterator i = this->begin(); i != this->end(); ++i) fn(*i);}
+			template<class Fn, class Policy> inline void for_each(Fn fn, const Policy &policy) const
+			{
+				policy.run(this->objects, this->length, [&](size_t, size_t begin, size_t end){for(size_t i=begin; i<end; i++) fn(this->objects[i]);});
 			}
 
-			/* Returns a reference to element n of self. The result can be used as an lvalue.
-			 * The index n must be between 0 and the size less one. */
-			inline T &operator[](const size_t index);
+			template<class Op> inline value_type reduce(value_type init, Op op) const
+			{
+				for(iterator i = this->begin(); i != this->end(); ++i) init = op(init, *i);
+				return init;
+			}
+			template<class Op, class Policy> inline value_type reduce(value_type init, Op op, const Policy &policy) const;
+
+			/* The search members of iVector, on the SIMD kernels for arithmetic T. */
+			inline iterator find(const value_type &x) const{return this->objects + detail::search<value_type>::find(this->objects, this->length, x);}
+			inline size_t count(const value_type &x) const{return detail::search<value_type>::count(this->objects, this->length, x);}
+			inline bool contains(const value_type &x) const{return this->find(x) != this->end();}
+			inline iterator min_element(void) const{return this->objects + detail::search<value_type>::min_element(this->objects, this->length);}
+			inline iterator max_element(void) const{return this->objects + detail::search<value_type>::max_element(this->objects, this->length);}
+			inline value_type sum(void) const{return detail::search<value_type>::sum(this->objects, this->length);}
+
+			/* Returns the sum of the products of the elements of self and rhs, up to the shorter size. */
+			inline value_type dot(const iSpan<const value_type> &rhs) const
+			{
+				return detail::search<value_type>::dot(this->objects, rhs.data(), this->length < rhs.size() ? this->length : rhs.size());
+			}
 
-			/* Returns a constant reference to element n of self.
-			 * The index n must be between 0 and the size less one. */
-			inline const T &operator[](const size_t index) const;
+		// Iterators
+			inline iterator begin(void) const{return this->objects;}
+			inline iterator end(void) const{return this->objects + this->length;}
+			inline const_iterator cbegin(void) const{return this->objects;}
+			inline const_iterator cend(void) const{return this->objects + this->length;}
+	};
 
+	template<class T> template<class Op, class Policy>
+	typename iSpan<T>::value_type iSpan<T>::reduce(value_type init, Op op, const Policy &policy) const
+	{
+		const size_t chunks = policy.chunks(this->length);
+		if(chunks < 2) return this->reduce(init, op);
 
-		// Iterators
+		iVector<value_type> partial(init, chunks);
+		iVector<unsigned char> used(static_cast<unsigned char>(0), chunks);
+		policy.run(this->objects, this->length, [&](size_t c, size_t begin, size_t end)
+		{
+			if(begin == end) return;
+			value_type sum = this->objects[begin];
+			for(size_t i=begin + 1; i<end; i++) sum = op(sum, this->objects[i]);
+			partial[c] = std::move(sum);
+			used[c] = 1;
+		});
+		for(size_t c=0; c<chunks; c++)
+			if(used[c]) init = op(init, partial[c]);
+		return init;
+	}
 
-			/* Returns a random access const_reverse_iterator that points to the past-the-end value. */
-			inline const_reverse_iterator rbegin(void) const{return &this->operator[](this->size() - 1);}
+	template<class T> void iSpan<T>::rotate(const size_t k) const
+	{
+		if(this->empty() || k % this->length == 0) return;
+		iterator middle = this->begin() + k % this->length;
+		if(is_trivially_relocatable<value_type>::value)
+		{	// three reversals, each one runs on the SIMD kernel
+			detail::reverse_range(this->begin(), middle);
+			detail::reverse_range(middle, this->end());
+			detail::reverse_range(this->begin(), this->end());
+		}
+		else std::rotate(this->begin(), middle, this->end());
+	}
 
-			/* Returns a random access const_reverse_iterator that points to the first element. */
-			inline const_reverse_iterator rend(void) const
-			{
-				const_reverse_iterator src(&(*(this->objects - 1)));
-				return src;
-			}
+	/* Class: iSnapshotReader<T, Codec>:
+		Reads a snapshot of iVector::save or iSnapshotWriter piece by piece, so a snapshot larger
+		than the memory can be processed in parts. iVector::load reads all parts at once.
+	*/
+	template<class T, class Codec> class iSnapshotReader
+	{
+		private:
+		// Attributes
+			std::istream *is;
+			Codec coder;
+			detail::snapshot_header header;
+			uint64_t remaining;		// elements left in the current chunk
+			bool ok, ended;
 
-			/* Returns a random access iterator that points to the first element. */
-			inline iterator begin(void){return &this->operator[](0);}
+		public:
+		// Constructors
+			/* Reads and checks the header. See good(). */
+			inline explicit iSnapshotReader(std::istream &is, const Codec &coder = Codec());
 
-			/* Returns a random access const_iterator that points to the first element. */
-			inline const_iterator begin(void) const{return &this->operator[](0);}
+		// Methods
+			/* Returns the number of elements in the snapshot, detail::SNAPSHOT_UNKNOWN if the writer did not know it. */
+			inline uint64_t size(void) const{return this->header.size;}
 
-			/* Returns a random access iterator that points to the past-the-end value. */
-			inline iterator end(void){return &this->operator[](this->size());}
+			/* Returns false if the header does not match T and Codec or a read failed. */
+			inline bool good(void) const{return this->ok;}
 
-			/* Returns a random access const_iterator that points to the past-the-end value. */
-			inline const_iterator end(void) const{return &this->operator[](this->size());}
+			/* Returns true if all elements were read. */
+			inline bool finished(void) const{return this->ok && this->ended;}
 
-			/* Returns a random access reverse_iterator that points to the past-the-end value. */
-			inline reverse_iterator rbegin(void)
+			/* Appends up to maxElements elements to out. Returns the number of appended elements, 0 at the end. */
+			template<class P, class A> inline size_t read(iVector<T, P, A> &out, const size_t maxElements);
+	};
+
+	template<class T, class Codec> iSnapshotReader<T, Codec>::iSnapshotReader(std::istream &is, const Codec &coder):
+		is(&is), coder(coder), remaining(0), ok(false), ended(false)
+	{
+		if(!is.read(reinterpret_cast<char *>(&this->header), sizeof(this->header))) return;
+		const bool raw = (this->header.flags & detail::SNAPSHOT_RAW) != 0;
+		this->ok = std::memcmp(this->header.magic, "GTIVSNP", 8) == 0 && this->header.version == detail::SNAPSHOT_VERSION
+				&& raw == Codec::raw && (!raw || this->header.elementSize == sizeof(T));
+		if((this->header.flags & detail::SNAPSHOT_CHUNKED) == 0)
+		{
+			this->remaining = this->header.size;
+			this->ended = this->remaining == 0;
+		}
+	}
+
+	template<class T, class Codec> template<class P, class A> size_t iSnapshotReader<T, Codec>::read(iVector<T, P, A> &out, const size_t maxElements)
+	{
+		size_t total = 0;
+		while(this->ok && !this->ended && total < maxElements)
+		{
+			if(this->remaining == 0)
+			{	// next chunk
+				if(!this->is->read(reinterpret_cast<char *>(&this->remaining), sizeof(this->remaining))) this->ok = false;
+				else if(this->remaining == 0) this->ended = true;
+				continue;
+			}
+			const size_t n = size_t(std::min<uint64_t>(this->remaining, maxElements - total));
+			try
 			{
-				reverse_iterator src(&(*(this->objects + this->size() - 1)));
-				return src;
+				if(out.size() + n > out.capacity()) out.reserve(out.grown_capacity(out.size() + n));
 			}
+			catch(const std::bad_alloc &)
+			{	// a broken chunk size
+				this->ok = false;
+				break;
+			}
+			if(Codec::raw)
+			{	// one block into the storage
+				this->is->read(reinterpret_cast<char *>(out.objects + out.size()), std::streamsize(sizeof(T) * n));
+				const size_t got = size_t(this->is->gcount()) / sizeof(T);
+				out.core.actualSize += got;
+				if(got != n) this->ok = false;
+			}
+			else for(size_t i=0; i<n && this->ok; i++)
+			{
+				T x;
+				if(this->coder.read(*this->is, x)) out.emplace_back(std::move(x));
+				else this->ok = false;
+			}
+			this->remaining -= n;
+			total += n;
+			if(this->remaining == 0 && (this->header.flags & detail::SNAPSHOT_CHUNKED) == 0) this->ended = true;
+		}
+		return this->ok ? total : 0;
+	}
 
-			/* Returns a random access reverse_iterator that points to the first element. */
-			inline reverse_iterator rend(void)
+	/* Class: iSnapshotWriter<T, Codec>:
+		Writes a snapshot in chunks, for content that is produced piece by piece or does not fit
+		into the memory at once. Read it with iVector::load or iSnapshotReader. finish() (or the
+		dtor) ends the snapshot and fills in the size if the stream can seek back.
+	*/
+	template<class T, class Codec = codec<T> > class iSnapshotWriter
+	{
+		private:
+		// Attributes
+			std::ostream *os;
+			Codec coder;
+			std::streampos start;	// position of the header, -1 if the stream cannot seek
+			uint64_t count;
+			bool ok, finished;
+
+		public:
+		// Constructors
+			/* Writes the header. */
+			inline explicit iSnapshotWriter(std::ostream &os, const Codec &coder = Codec()):
+				os(&os), coder(coder), start(os.tellp()), count(0), finished(false)
 			{
-				reverse_iterator src(&(*(this->objects - 1)));
-				return src;
+				const detail::snapshot_header header = detail::make_snapshot_header(Codec::raw, sizeof(T), true, detail::SNAPSHOT_UNKNOWN);
+				this->ok = bool(os.write(reinterpret_cast<const char *>(&header), sizeof(header)));
 			}
+
+			iSnapshotWriter(const iSnapshotWriter<T, Codec> &) = delete;
+			iSnapshotWriter<T, Codec> &operator=(const iSnapshotWriter<T, Codec> &) = delete;
+
+		// Destructor
+			~iSnapshotWriter(){if(!this->finished) this->finish();}
+
+		// Methods
+			/* Appends the n elements at first as one chunk. Returns false on a stream error. */
+			inline bool write(const T *first, const size_t n);
+
+			/* Appends the elements of chunk. */
+			template<class P, class A> inline bool write(const iVector<T, P, A> &chunk){return this->write(chunk.begin(), chunk.size());}
+
+			/* Ends the snapshot. Returns false if any write failed. */
+			inline bool finish(void);
+
+			/* Returns the number of written elements. */
+			inline uint64_t size(void) const{return this->count;}
+
+			/* Returns false if a write failed. */
+			inline bool good(void) const{return this->ok;}
 	};
 
-	template<class T> iVector<T>::~iVector()
+	template<class T, class Codec> bool iSnapshotWriter<T, Codec>::write(const T *first, const size_t n)
 	{
-		delete[] this->objects;
+		if(n == 0 || !this->ok || this->finished) return this->ok && !this->finished;
+		const uint64_t chunk = n;
+		this->ok = bool(this->os->write(reinterpret_cast<const char *>(&chunk), sizeof(chunk)));
+		if(Codec::raw)
+			this->ok = this->ok && this->os->write(reinterpret_cast<const char *>(first), std::streamsize(sizeof(T) * n));
+		else for(const T *last = first + n; this->ok && first != last; ++first)
+			this->ok = this->coder.write(*this->os, *first);
+		if(this->ok) this->count += n;
+		return this->ok;
 	}
 
-	template<class T> size_t iVector<T>::shift_left(void)
+	template<class T, class Codec> bool iSnapshotWriter<T, Codec>::finish(void)
 	{
-		if(this->core.bearingsCount < AUTO_MAXIMAL_OVERFLOW)
-			return ADJUST_BASE_NUMBER << (this->core.bearingsCount = this->core.ascending++);
-		else return ADJUST_BASE_NUMBER << this->core.bearingsCount;
+		if(this->finished) return this->ok;
+		this->finished = true;
+		const uint64_t end = 0;
+		this->ok = this->ok && this->os->write(reinterpret_cast<const char *>(&end), sizeof(end));
+		if(this->ok && this->start != std::streampos(-1))
+		{	// fill in the size, load can reserve once then
+			const std::streampos last = this->os->tellp();
+			if(this->os->seekp(this->start + std::streamoff(offsetof(detail::snapshot_header, size))))
+			{
+				this->os->write(reinterpret_cast<const char *>(&this->count), sizeof(this->count));
+				this->os->seekp(last);
+			}
+			else this->os->clear();
+		}
+		this->os->flush();
+		return this->ok && bool(*this->os);
 	}
 
-	template<class T> size_t iVector<T>::shift_right(void)
+	template<class T, class GrowthPolicy, class Allocator> template<class Codec> bool iVector<T, GrowthPolicy, Allocator>::save(std::ostream &os, const Codec &coder) const
 	{
-		this->core.bearingsCount = --this->core.ascending;
-		return this->core.actualCapacity >> ADJUST_BASE_NUMBER;
+		const detail::snapshot_header header = detail::make_snapshot_header(Codec::raw, sizeof(T), false, this->size());
+		if(!os.write(reinterpret_cast<const char *>(&header), sizeof(header))) return false;
+		if(Codec::raw)
+			return this->empty() || bool(os.write(reinterpret_cast<const char *>(this->objects), std::streamsize(sizeof(T) * this->size())));
+		for(const_iterator i = this->begin(); i != this->end(); ++i)
+			if(!coder.write(os, *i)) return false;
+		return true;
 	}
 
-	template<class T> iVector<T> &iVector<T>::operator=(const iVector<T> &rhs)
+	template<class T, class GrowthPolicy, class Allocator> template<class Codec> bool iVector<T, GrowthPolicy, Allocator>::load(std::istream &is, const Codec &coder)
 	{
-		if(this != &rhs)
+		this->clear();
+		iSnapshotReader<T, Codec> reader(is, coder);
+		if(reader.good() && reader.size() != detail::SNAPSHOT_UNKNOWN)
+		{
+			try
+			{
+				this->reserve(size_t(reader.size()));
+			}
+			catch(const std::bad_alloc &)
+			{	// the size of a broken header, the reader fails on its own
+			}
+		}
+		try
 		{
-			delete[] this->objects;
-			this->core.operator=(rhs.getCore());
-			this->objects = GT_ALLOCATER_T T[this->capacity()];
-			iterator i = this->begin();
-			for(const_iterator it = rhs.begin(); it != rhs.end(); it++, i++)
-                *i = *it;
+			while(reader.read(*this, size_t(-1)) != 0){}
+			if(reader.finished()) return true;
+		}
+		catch(...)
+		{	// the codec or an element failed on broken data
+		}
+
+        #ifdef GT_CERR_ACTIVE
+		std::cerr << "IN FUNCTION: template<class T, class GrowthPolicy, class Allocator> template<class Codec> bool iVector<T, GrowthPolicy, Allocator>::load(std::istream &is, const Codec &coder);" << std::endl;
+		std::cerr << "THE SNAPSHOT IS BROKEN OR WAS NOT WRITTEN FOR THIS DATATYPE." << std::endl;
+        #endif
+		this->clear();
+		return false;
+	}
+
+	template<class T, class GrowthPolicy, class Allocator> iVector<T, GrowthPolicy, Allocator>::~iVector()
+	{
+		detail::destroy_range(this->allocator_ref(), this->begin(), this->end());
+		this->deallocate_array(this->objects, this->core.actualCapacity);
+	}
+
+	template<class T, class GrowthPolicy, class Allocator> iVector<T, GrowthPolicy, Allocator> &iVector<T, GrowthPolicy, Allocator>::operator=(const iVector<T, GrowthPolicy, Allocator> &rhs)
+	{
+		if(this != &rhs)
+		{	// copy first with the allocator self has afterwards, self is unchanged if that throws
+			Allocator alloc(this->allocator_ref());
+			detail::assign_allocator(alloc, rhs.allocator_ref(), typename alloc_traits::propagate_on_container_copy_assignment());
+			iVector<T, GrowthPolicy, Allocator> copy(rhs, alloc);
+			this->steal(copy);
+			detail::assign_allocator(this->allocator_ref(), rhs.allocator_ref(),
+					typename alloc_traits::propagate_on_container_copy_assignment());
 		}
 		return *this;
 	}
 
-	template<class T> void iVector<T>::clear(void)
+	template<class T, class GrowthPolicy, class Allocator> iVector<T, GrowthPolicy, Allocator> &iVector<T, GrowthPolicy, Allocator>::operator=(iVector<T, GrowthPolicy, Allocator> &&rhs)
+			noexcept(alloc_traits::propagate_on_container_move_assignment::value)
 	{
-		delete[] this->objects;
-		this->core.setHusk(0, 0, 0, (FIRST_RESERVE_AMOUNT < 1) ? 1 : FIRST_RESERVE_AMOUNT);
-		this->objects = GT_ALLOCATER_T T[(FIRST_RESERVE_AMOUNT < 1) ? 1 : FIRST_RESERVE_AMOUNT];
-		if(this->objects == null_ptr)
-		{	// 1. ascending   2. bearingsCount   3. actualSize   4. actualCapacity
-            #ifdef GT_CERR_ACTIVE
-			std::cerr << "IN FUNCTION: template<class T> void iVector<T>::clear(void);" << std::endl;
-			std::cerr << "NOT ENOUGHT MEMORY." << std::endl;
-            #endif
+		if(this != &rhs)
+			this->move_assign(rhs, typename alloc_traits::propagate_on_container_move_assignment());
+		return *this;
+	}
+
+	template<class T, class GrowthPolicy, class Allocator> void iVector<T, GrowthPolicy, Allocator>::steal(iVector<T, GrowthPolicy, Allocator> &rhs)
+	{
+		detail::destroy_range(this->allocator_ref(), this->begin(), this->end());
+		this->deallocate_array(this->objects, this->core.actualCapacity);
+		this->setCore(rhs.getCore());
+		this->objects = rhs.objects;
+		rhs.release();
+	}
+
+	template<class T, class GrowthPolicy, class Allocator> void iVector<T, GrowthPolicy, Allocator>::move_assign(iVector<T, GrowthPolicy, Allocator> &rhs, std::true_type)
+	{
+		this->steal(rhs);
+		detail::assign_allocator(this->allocator_ref(), rhs.allocator_ref(), std::true_type());
+	}
 
+	template<class T, class GrowthPolicy, class Allocator> void iVector<T, GrowthPolicy, Allocator>::move_assign(iVector<T, GrowthPolicy, Allocator> &rhs, std::false_type)
+	{
+		if(this->allocator_ref() == rhs.allocator_ref())
+		{
+			this->steal(rhs);
 			return;
 		}
+		// the storage of rhs belongs to another allocator: move the elements
+		detail::destroy_range(this->allocator_ref(), this->begin(), this->end());
+		this->core.actualSize = 0;
+		if(rhs.size() > this->core.actualCapacity && !this->reallocate(rhs.size())) throw std::bad_alloc();
+		detail::uninitialized_copy_range(this->allocator_ref(),
+				std::make_move_iterator(rhs.begin()), std::make_move_iterator(rhs.end()), this->objects);
+		this->core.actualSize = rhs.size();
+		detail::destroy_range(rhs.allocator_ref(), rhs.begin(), rhs.end());
+		rhs.core.actualSize = 0;
+	}
+
+	template<class T, class GrowthPolicy, class Allocator> void iVector<T, GrowthPolicy, Allocator>::release(void)
+	{	// 1. ascending   2. bearingsCount   3. actualSize   4. actualCapacity
+		this->core.setHusk(0, 0, 0, 0);
+		this->objects = null_ptr;
+	}
+
+	template<class T, class GrowthPolicy, class Allocator> void iVector<T, GrowthPolicy, Allocator>::clear(void)
+	{
+		detail::destroy_range(this->allocator_ref(), this->begin(), this->end());
+		this->core.actualSize = 0;
+		const size_t newCapacity = GrowthPolicy::shrink(this->core);
+		if(newCapacity < this->core.actualCapacity) this->reallocate(newCapacity);
 	}
 
-	template<class T> void iVector<T>::resize(const size_t newSize)
+	template<class T, class GrowthPolicy, class Allocator> void iVector<T, GrowthPolicy, Allocator>::resize(const size_t newSize)
 	{
 		if(newSize > this->core.actualCapacity)
-			this->reserve(newSize * 2 + 1);
+			this->reserve(this->grown_capacity(newSize));
+		if(newSize > this->core.actualSize)
+			detail::uninitialized_fill_range(this->allocator_ref(), this->end(), newSize - this->core.actualSize, T());
+		else
+			detail::destroy_range(this->allocator_ref(), this->begin() + newSize, this->end());
 		this->core.actualSize = newSize;
 	}
 
-	template<class T> void iVector<T>::reserve(const size_t newCapacity)
+	template<class T, class GrowthPolicy, class Allocator> void iVector<T, GrowthPolicy, Allocator>::reserve(const size_t newCapacity)
 	{
-		if(newCapacity < this->core.actualSize) return;
-		T *oldArray = this->objects;
+		if(newCapacity <= this->core.actualCapacity) return;
+		if(this->core.actualCapacity == 0) GrowthPolicy::initial(this->core, newCapacity); // first allocation
+		if(!this->reallocate(newCapacity)) throw std::bad_alloc();
+	}
 
-		this->objects = GT_ALLOCATER_T T[newCapacity];
-		if(this->objects == null_ptr)
+	template<class T, class GrowthPolicy, class Allocator> bool iVector<T, GrowthPolicy, Allocator>::reallocate(const size_t newCapacity)
+	{
+		if(newCapacity == 0)
+		{	// only reached without elements
+			this->deallocate_array(this->objects, this->core.actualCapacity);
+			this->objects = null_ptr;
+			this->core.actualCapacity = 0;
+			return true;
+		}
+		const detail::can_reallocate<Allocator, T> inPlace = detail::can_reallocate<Allocator, T>();
+		T *newArray = null_ptr;
+		if(!inPlace)
+		{
+			try
+			{
+				newArray = this->allocate_array(newCapacity);
+			}
+			catch(const std::bad_alloc &)
+			{
+				return false;	// reported by allocate_array
+			}
+		}
+		else if((newArray = detail::reallocate_storage(this->allocator_ref(), this->objects, this->core.actualCapacity, newCapacity, inPlace)) == null_ptr)
 		{
             #ifdef GT_CERR_ACTIVE
-			std::cerr << "IN FUNCTION: template<class T> void iVector<T>::reserve(const size_t newCapacity);" << std::endl;
+			std::cerr << "IN FUNCTION: template<class T, class GrowthPolicy, class Allocator> bool iVector<T, GrowthPolicy, Allocator>::reallocate(const size_t newCapacity);" << std::endl;
 			std::cerr << "NOT ENOUGHT MEMORY." << std::endl;
             #endif
+			return false;
 		}
-		else
+		if(!inPlace)
 		{
-			for(size_t i=0; i<this->core.actualSize; i++) this->objects[i] = oldArray[i];
-			this->core.actualCapacity = newCapacity;
-			delete[] oldArray;
+			detail::relocate_range(this->allocator_ref(), this->begin(), this->end(), newArray);
+			this->deallocate_array(this->objects, this->core.actualCapacity);
 		}
+		this->objects = newArray;
+		this->core.actualCapacity = newCapacity;
+		return true;
 	}
 
-	template<class T> void iVector<T>::insert(const T new_item, const size_t position)
+	template<class T, class GrowthPolicy, class Allocator> void iVector<T, GrowthPolicy, Allocator>::insert(const T new_item, const size_t position)
 	{
-		iVector<T> temp;
-		if(temp.capacity() < (this->size() + 1)) temp.reserve(this->size() + 1);
-		position = position > (this->size()) ? (this->size()) : position;
-		for(size_t i=0, j=0; i<this->size()+1; i++, j++)
-		{
-			if(i != position) temp.push_back(this->operator[](j));
-			else
-			{
-				temp.push_back(new_item);
-				j--;
-			}
-		}
-		this->operator=(temp);
+		this->emplace(this->begin() + (position > this->size() ? this->size() : position), new_item);
 	}
 
-	template<class T> void iVector<T>::swap(iVector<T> &src)
+	template<class T, class GrowthPolicy, class Allocator> void iVector<T, GrowthPolicy, Allocator>::swap(iVector<T, GrowthPolicy, Allocator> &src)
 	{
-		if(this->objects != src.objects)
+		if(this != &src)
 		{
+			detail::swap_allocator(this->allocator_ref(), src.allocator_ref(), typename alloc_traits::propagate_on_container_swap());
 			T *tmpArray = this->objects;
 			husk_t tmp(this->getCore());
 			this->setCore(src.getCore());
@@ -794,155 +2754,299 @@ namespace GT
 		}
 	}
 
-	template<class T> void iVector<T>::mirror(void)
+	template<class T, class GrowthPolicy, class Allocator> template<class Compare>
+	iVector<T, GrowthPolicy, Allocator> iVector<T, GrowthPolicy, Allocator>::top_k(const size_t k, Compare comp) const
+	{
+		iVector<T, GrowthPolicy, Allocator> out(0, this->get_allocator());
+		detail::select_top(this->objects, this->objects + this->size(), k, comp, out);
+		return out;
+	}
+
+	template<class T, class GrowthPolicy, class Allocator> template<class Compare, class Policy>
+	iVector<T, GrowthPolicy, Allocator> iVector<T, GrowthPolicy, Allocator>::top_k(const size_t k, Compare comp, const Policy &policy) const
+	{
+		iVector<T, GrowthPolicy, Allocator> out(0, this->get_allocator());
+		detail::select_top(this->objects, this->size(), k, comp, policy, out);
+		return out;
+	}
+
+	template<class T, class GrowthPolicy, class Allocator> template<class Make, class Policy>
+	void iVector<T, GrowthPolicy, Allocator>::rebuild(const size_t n, Make make, const Policy &policy)
 	{
-		if(!this->empty())
+		this->clear();
+		if(n > this->core.actualCapacity)
+		{	// fresh pages, untouched until the threads construct in them
+			this->reallocate(0);
+			this->reserve(n);	// throws std::bad_alloc if out of memory
+		}
+		if(std::is_nothrow_copy_constructible<T>::value)
+		{
+			policy.run(this->objects, n, [&](size_t, size_t begin, size_t end){for(size_t i=begin; i<end; i++) make(this->objects + i, i);});
+			this->core.actualSize = n;
+		}
+		else for(size_t i=0; i<n; i++)
 		{
-			iterator i = GT_ALLOCATER_T T[this->core.actualCapacity], temp = i;
-			for(reverse_iterator r = this->rbegin(); r != this->rend(); r++, i++) 
-                *i = *r;
-			delete[] this->objects;
-			this->objects = temp;
+			make(this->objects + i, i);
+			this->core.actualSize++;
 		}
 	}
 
-	template<class T> void iVector<T>::setCore(const husk_t &src)
+	template<class T, class GrowthPolicy, class Allocator> void iVector<T, GrowthPolicy, Allocator>::setCore(const husk_t &src)
 	{
 		this->core = src;
 	}
 
-	template<class T> void iVector<T>::kill_item(const size_t index)
+	template<class T, class GrowthPolicy, class Allocator> void iVector<T, GrowthPolicy, Allocator>::assign(const iVector<T, GrowthPolicy, Allocator> &src)
 	{
-		iVector<T> temp;
-		for(size_t i=0; i<this->size(); i++)
-			if(i != index) 
-                temp.push_back(this->operator[](i));
-		this->operator=(temp);
+		this->operator=(src);
 	}
 
-	template<class T> void iVector<T>::assign(const iVector<T> &src)
+	template<class T, class GrowthPolicy, class Allocator> T &iVector<T, GrowthPolicy, Allocator>::front(void)
 	{
-		this->operator=(src);
+		return this->operator[](0);
 	}
 
-	template<class T> T &iVector<T>::front(void)
+	template<class T, class GrowthPolicy, class Allocator> const T &iVector<T, GrowthPolicy, Allocator>::front(void) const
 	{
 		return this->operator[](0);
 	}
 
-	template<class T> const T &iVector<T>::front(void) const
+	template<class T, class GrowthPolicy, class Allocator> void iVector<T, GrowthPolicy, Allocator>::erase(const size_t begin, const size_t pieces)
 	{
-		return this->operator[](0);
+		if(begin < this->size())
+			this->erase(this->begin() + begin, this->begin() + (this->size() - begin < pieces ? this->size() : begin + pieces));
 	}
 
-	template<class T> void iVector<T>::erase(const size_t begin, const size_t pieces)
+	template<class T, class GrowthPolicy, class Allocator> typename iVector<T, GrowthPolicy, Allocator>::iterator iVector<T, GrowthPolicy, Allocator>::erase(const_iterator first, const_iterator last)
 	{
-		// iVector<T>::const_iterator iter = &this->operator[](begin);
-		// this->erase(iter, pieces);
-		for(size_t i=0; i<pieces; i++)
-            this->kill_item(begin);
+		const size_t index = first - this->begin();
+		if(first < last)
+		{
+			detail::destroy_range(this->allocator_ref(), const_cast<iterator>(first), const_cast<iterator>(last));
+			detail::relocate_overlapping(this->allocator_ref(), const_cast<iterator>(last), this->end(), const_cast<iterator>(first));
+			this->core.actualSize -= last - first;
+
+			const size_t newCapacity = GrowthPolicy::shrink(this->core);
+			if(newCapacity < this->core.actualCapacity) this->reallocate(newCapacity);
+		}
+		return this->begin() + index;
 	}
 
-	template<class T> T &iVector<T>::operator[](const size_t index)
+	template<class T, class GrowthPolicy, class Allocator> T &iVector<T, GrowthPolicy, Allocator>::operator[](const size_t index)
 	{
 		return this->objects[index];
 	}
 
-	template<class T> const T &iVector<T>::operator[](const size_t index) const
+	template<class T, class GrowthPolicy, class Allocator> const T &iVector<T, GrowthPolicy, Allocator>::operator[](const size_t index) const
 	{
 		return this->objects[index];
 	}
 
-	template<class T> bool iVector<T>::empty(void) const
+	template<class T, class GrowthPolicy, class Allocator> bool iVector<T, GrowthPolicy, Allocator>::empty(void) const
 	{
 		return bool(this->size() == 0);
 	}
 
-	template<class T> size_t iVector<T>::size(void) const
+	template<class T, class GrowthPolicy, class Allocator> size_t iVector<T, GrowthPolicy, Allocator>::size(void) const
 	{
 		return this->core.actualSize;
 	}
 
-	template<class T> size_t iVector<T>::capacity(void) const
+	template<class T, class GrowthPolicy, class Allocator> size_t iVector<T, GrowthPolicy, Allocator>::capacity(void) const
 	{
 		return this->core.actualCapacity;
 	}
 
-	template<class T> husk_t iVector<T>::getCore(void) const
+	template<class T, class GrowthPolicy, class Allocator> husk_t iVector<T, GrowthPolicy, Allocator>::getCore(void) const
 	{
 		return this->core;
 	}
 
-	template<class T> void iVector<T>::pop_front(void)
+	template<class T, class GrowthPolicy, class Allocator> void iVector<T, GrowthPolicy, Allocator>::pop_front(void)
 	{
 		this->erase(this->begin());
 	}
 
-	template<class T> void iVector<T>::push_front(const T &x)
+	template<class T, class GrowthPolicy, class Allocator> void iVector<T, GrowthPolicy, Allocator>::push_front(const T &x)
+	{
+		this->emplace(this->begin(), x);
+	}
+
+	template<class T, class GrowthPolicy, class Allocator> template<class... Args> typename iVector<T, GrowthPolicy, Allocator>::iterator iVector<T, GrowthPolicy, Allocator>::emplace(const_iterator position, Args&&... args)
+	{
+		const size_t index = position - this->begin();
+		if(index >= this->size())
+			return &this->emplace_back(std::forward<Args>(args)...);
+
+		T item(std::forward<Args>(args)...); // args may refer into self
+		alloc_traits::construct(this->allocator_ref(), this->make_gap(index, 1), std::move(item));
+		this->core.actualSize++;
+		return this->begin() + index;
+	}
+
+	template<class T, class GrowthPolicy, class Allocator> typename iVector<T, GrowthPolicy, Allocator>::iterator iVector<T, GrowthPolicy, Allocator>::insert(const_iterator position, const T &x)
 	{
-		iVector<T> tmp(x, 1);
-		for(iterator i=this->begin(); i!=this->end(); i++)
-            tmp.push_back(*i);
-		this->operator=(tmp);
+		return this->emplace(position, x);
 	}
 
-	template<class T> void iVector<T>::push_back(const T &x)
+	template<class T, class GrowthPolicy, class Allocator> typename iVector<T, GrowthPolicy, Allocator>::iterator iVector<T, GrowthPolicy, Allocator>::insert(const_iterator position, T &&x)
 	{
-	#if defined(GT_ACTIVATE_AUTOMATIC_MODE_FOR_OVERFLOW)
-		if(this->core.actualSize == (this->core.actualCapacity - AUTO_MINIMAL_OVERFLOW))
-			this->reserve(this->core.actualCapacity + this->shift_left());
-		this->objects[this->core.actualSize++] = x;
-	#else
-		if(MAXIMAL_OVERFLOW == 0)
+		return this->emplace(position, std::move(x));
+	}
+
+	template<class T, class GrowthPolicy, class Allocator> typename iVector<T, GrowthPolicy, Allocator>::iterator iVector<T, GrowthPolicy, Allocator>::insert(const_iterator position, const size_t n, const T &x)
+	{
+		const size_t index = position - this->begin();
+		if(n != 0)
 		{
-			if(this->core.actualSize == (this->core.actualCapacity - MINIMAL_OVERFLOW))
-				this->reserve(this->core.actualCapacity + 1);
-			this->objects[this->core.actualSize++] = x;
+			const T item(x); // x may refer into self
+			detail::uninitialized_fill_range(this->allocator_ref(), this->make_gap(index, n), n, item);
+			this->core.actualSize += n;
 		}
-		else
+		return this->begin() + index;
+	}
+
+	template<class T, class GrowthPolicy, class Allocator> template<class InputIterator, class> typename iVector<T, GrowthPolicy, Allocator>::iterator iVector<T, GrowthPolicy, Allocator>::insert(const_iterator position, InputIterator first, InputIterator last)
+	{
+		return this->insert_range(position - this->begin(), first, last, typename std::iterator_traits<InputIterator>::iterator_category());
+	}
+
+	template<class T, class GrowthPolicy, class Allocator> template<class InputIterator> T *iVector<T, GrowthPolicy, Allocator>::insert_range(const size_t index,
+			InputIterator first, InputIterator last, std::input_iterator_tag)
+	{	// the length is unknown: append and rotate the new elements into place
+		const size_t oldSize = this->size();
+		for(; first != last; ++first) this->emplace_back(*first);
+		std::rotate(this->begin() + index, this->begin() + oldSize, this->end());
+		return this->begin() + index;
+	}
+
+	template<class T, class GrowthPolicy, class Allocator> template<class ForwardIterator> T *iVector<T, GrowthPolicy, Allocator>::insert_range(const size_t index,
+			ForwardIterator first, ForwardIterator last, std::forward_iterator_tag)
+	{
+		const size_t n = std::distance(first, last);
+		if(n != 0)
 		{
-			if(this->core.actualSize == (this->core.actualCapacity - MINIMAL_OVERFLOW))
-				this->reserve(this->core.actualCapacity + MAXIMAL_OVERFLOW);
-			this->objects[this->core.actualSize++] = x;
+			detail::uninitialized_copy_range(this->allocator_ref(), first, last, this->make_gap(index, n));
+			this->core.actualSize += n;
 		}
-	#endif // GT_ACTIVATE_AUTOMATIC_MODE_FOR_OVERFLOW
+		return this->begin() + index;
 	}
 
-	template<class T> void iVector<T>::pop_back(void)
+	template<class T, class GrowthPolicy, class Allocator> T *iVector<T, GrowthPolicy, Allocator>::make_gap(const size_t index, const size_t count)
 	{
-	#if defined(GT_ACTIVATE_AUTOMATIC_MODE_FOR_OVERFLOW)
-		if((this->core.actualCapacity - this->core.actualSize-- + 1) > this->shift_right())
+		const size_t required = this->core.actualSize + count;
+		if(required > this->core.actualCapacity)
 		{
-			const T *oldArray = this->objects;
+			const size_t newCapacity = this->grown_capacity(required);
+			if(!detail::can_reallocate<Allocator, T>::value)
+			{	// relocate both halves straight to their new place
+				T *newArray = this->allocate_array(newCapacity);
+				detail::relocate_range(this->allocator_ref(), this->begin(), this->begin() + index, newArray);
+				detail::relocate_range(this->allocator_ref(), this->begin() + index, this->end(), newArray + index + count);
+				this->deallocate_array(this->objects, this->core.actualCapacity);
+				this->objects = newArray;
+				this->core.actualCapacity = newCapacity;
+				return this->objects + index;
+			}
+			if(!this->reallocate(newCapacity)) throw std::bad_alloc();
+		}
+		detail::relocate_overlapping(this->allocator_ref(), this->begin() + index, this->end(), this->begin() + index + count);
+		return this->objects + index;
+	}
 
-			this->objects = GT_ALLOCATER_T T[this->core.actualSize + 1];
-			for(size_t i=0; i<this->core.actualSize; i++)
-				this->objects[i] = oldArray[i];
-			this->core.actualCapacity = this->core.actualSize + 1;
-			delete[] oldArray;
+	template<class T, class GrowthPolicy, class Allocator> T *iVector<T, GrowthPolicy, Allocator>::allocate_array(const size_t n)
+	{
+		if(n == 0) return null_ptr;
+		try
+		{
+			return alloc_traits::allocate(this->allocator_ref(), n);
 		}
-	#else
-		if((this->core.actualCapacity - this->core.actualSize--) > REMOVE_IF_IT_IS_LARGER)
+		catch(const std::bad_alloc &)
 		{
-			T *oldArray = this->objects;
+            #ifdef GT_CERR_ACTIVE
+			std::cerr << "IN FUNCTION: template<class T, class GrowthPolicy, class Allocator> T *iVector<T, GrowthPolicy, Allocator>::allocate_array(const size_t n);" << std::endl;
+			std::cerr << "NOT ENOUGHT MEMORY." << std::endl;
+            #endif
+			throw;
+		}
+	}
+
+	template<class T, class GrowthPolicy, class Allocator> void iVector<T, GrowthPolicy, Allocator>::deallocate_array(T *p, const size_t n)
+	{
+		if(p != null_ptr) alloc_traits::deallocate(this->allocator_ref(), p, n);
+	}
+
+	template<class T, class GrowthPolicy, class Allocator> bool iVector<T, GrowthPolicy, Allocator>::exhausted(void) const
+	{
+		return this->core.actualSize >= this->core.actualCapacity;
+	}
+
+	template<class T, class GrowthPolicy, class Allocator> size_t iVector<T, GrowthPolicy, Allocator>::grown_capacity(const size_t required)
+	{
+		return this->core.actualCapacity == 0 ?
+				GrowthPolicy::initial(this->core, required) : GrowthPolicy::grow(this->core, required);
+	}
+
+	template<class T, class GrowthPolicy, class Allocator> void iVector<T, GrowthPolicy, Allocator>::push_back(const T &x)
+	{
+		this->emplace_back(x);
+	}
+
+	template<class T, class GrowthPolicy, class Allocator> void iVector<T, GrowthPolicy, Allocator>::push_back(T &&x)
+	{
+		this->emplace_back(std::move(x));
+	}
 
-			this->objects = GT_ALLOCATER_T T[this->core.actualSize + 1];
-			for(size_t i=0; i<core.actualSize; i++)
-				this->objects[i] = oldArray[i];
-			this->core.actualCapacity = this->core.actualSize + 1;
-			delete[] oldArray;
+	template<class T, class GrowthPolicy, class Allocator> template<class... Args> T &iVector<T, GrowthPolicy, Allocator>::emplace_back(Args&&... args)
+	{
+		if(this->exhausted() && detail::can_reallocate<Allocator, T>::value)
+		{	// realloc may release the old array, args may refer into it
+			T item(std::forward<Args>(args)...);
+			if(!this->reallocate(this->grown_capacity(this->core.actualSize + 1))) throw std::bad_alloc();
+			alloc_traits::construct(this->allocator_ref(), this->objects + this->core.actualSize, std::move(item));
+		}
+		else if(this->exhausted())
+		{	// construct the new element first, args may refer into the old array
+			const size_t newCapacity = this->grown_capacity(this->core.actualSize + 1);
+			T *newArray = this->allocate_array(newCapacity);
+			try
+			{
+				alloc_traits::construct(this->allocator_ref(), newArray + this->core.actualSize, std::forward<Args>(args)...);
+			}
+			catch(...)
+			{
+				this->deallocate_array(newArray, newCapacity);
+				throw;
+			}
+			detail::relocate_range(this->allocator_ref(), this->begin(), this->end(), newArray);
+			this->deallocate_array(this->objects, this->core.actualCapacity);
+			this->objects = newArray;
+			this->core.actualCapacity = newCapacity;
 		}
-	#endif // GT_ACTIVATE_AUTOMATIC_MODE_FOR_OVERFLOW
+		else alloc_traits::construct(this->allocator_ref(), this->objects + this->core.actualSize, std::forward<Args>(args)...);
+		return this->objects[this->core.actualSize++];
+	}
+
+	template<class T, class GrowthPolicy, class Allocator> void iVector<T, GrowthPolicy, Allocator>::pop_back(void)
+	{
+		alloc_traits::destroy(this->allocator_ref(), this->objects + --this->core.actualSize);
+		const size_t newCapacity = GrowthPolicy::shrink(this->core);
+		if(newCapacity < this->core.actualCapacity) this->reallocate(newCapacity);
+	}
+
+	template<class T, class GrowthPolicy, class Allocator> void iVector<T, GrowthPolicy, Allocator>::shrink_to_fit(void)
+	{
+		if(this->core.actualSize < this->core.actualCapacity) this->reallocate(this->core.actualSize);
 	}
 
-	template<class T> T &iVector<T>::at(const size_t index)
+	template<class T, class GrowthPolicy, class Allocator> T &iVector<T, GrowthPolicy, Allocator>::at(const size_t index)
 	{
 		if(index >= this->core.actualSize)
 		{
 			if(this->core.actualSize != 0)
 			{
                 #ifdef GT_CERR_ACTIVE
-				std::cerr << "IN FUNCTION: template<class T> T &iVector<T>::at(size_t index);" << std::endl;
+				std::cerr << "IN FUNCTION: template<class T, class GrowthPolicy, class Allocator> T &iVector<T, GrowthPolicy, Allocator>::at(size_t index);" << std::endl;
 				std::cerr << "Caution: The largest possible index of the \"at()\" function is " << this->core.actualSize - 1
 						  << " and you have entered the number " << index << " !!!" << std::endl;
                 #endif
@@ -956,14 +3060,14 @@ namespace GT
 		else return this->operator[](index);
 	}
 
-	template<class T> const T &iVector<T>::at(const size_t index) const
+	template<class T, class GrowthPolicy, class Allocator> const T &iVector<T, GrowthPolicy, Allocator>::at(const size_t index) const
 	{
 		if(index >= this->core.actualSize)
 		{
 			if(this->core.actualSize != 0)
 			{
                 #ifdef GT_CERR_ACTIVE
-				std::cerr << "IN FUNCTION: template<class T> const T &iVector<T>::at(size_t index) const;" << std::endl;
+				std::cerr << "IN FUNCTION: template<class T, class GrowthPolicy, class Allocator> const T &iVector<T, GrowthPolicy, Allocator>::at(size_t index) const;" << std::endl;
 				std::cerr << "Caution: The largest possible index of the \"at()\" function is " << this->core.actualSize - 1
 						  << " and you have entered the number " << index << " !!!" << std::endl;
                 #endif
@@ -977,9 +3081,26 @@ namespace GT
 		else return *(this->objects + index - 1);
 	}
 
-	template<class T> const T &iVector<T>::back(void) const
+	template<class T, class GrowthPolicy, class Allocator> T &iVector<T, GrowthPolicy, Allocator>::back(void)
+	{
+		return this->operator[](this->core.actualSize - 1);
+	}
+
+	template<class T, class GrowthPolicy, class Allocator> const T &iVector<T, GrowthPolicy, Allocator>::back(void) const
 	{
 		return this->operator[](this->core.actualSize - 1);
 	}
+
+    #ifdef GT_HAS_MEMORY_RESOURCE
+	namespace pmr
+	{
+		/* An iVector that takes its storage from a std::pmr::memory_resource, for example:
+			std::pmr::monotonic_buffer_resource arena;
+			GT::pmr::iVector<int> v(&arena);
+		   The storage of all vectors in the arena is released at once with the arena. */
+		template<class T, class GrowthPolicy = default_growth>
+		using iVector = GT::iVector<T, GrowthPolicy, std::pmr::polymorphic_allocator<T> >;
+	} // end of namespace pmr
+    #endif
 } // end of namespace GT
 #endif // IVECTOR_H
@@ -0,0 +1,119 @@
+/*--------------------------------------------------------------------------------------------------*/
+/*      Checks the SIMD search kernels of ivector.h against the plain loops of scalar_search.       */
+/*      Every instruction set the CPU supports is run (SSE2, AVX2, AVX-512), not only the one       */
+/*      iVector picks, on all arithmetic element types, lengths 0 to 300, unaligned starts,         */
+/*      random data and NaNs. Prints the failures and returns 1 if there are any. Build and run:    */
+/*          g++ -std=c++11 -O2 -I. tests/search_kernels.cpp -o search_kernels && ./search_kernels   */
+/*--------------------------------------------------------------------------------------------------*/
+
+#include "ivector.h"
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <typeinfo>
+
+#ifdef GT_HAS_SIMD
+namespace
+{
+	using GT::detail::scalar_search;
+	namespace simd = GT::detail::simd;
+
+	std::mt19937_64 rng(20141017);
+	size_t failures = 0;
+
+	void fail(const char *isa, const char *type, const char *kernel, const size_t n, const size_t offset)
+	{
+		if(++failures <= 50) std::printf("FAILED: %s %s %s, n = %zu, offset = %zu\n", isa, type, kernel, n, offset);
+	}
+
+	/* Small values, so that sums and dots of signed integers do not overflow in the loops */
+	template<class T> T random_value(void)
+	{
+		return T(std::uniform_int_distribution<int>(std::is_signed<T>::value ? -100 : 0, 100)(rng));
+	}
+
+	/* Equal for integers, within the rounding of n lane-wise additions for floating point */
+	template<class T> bool close(const T a, const T b, const T magnitude, const size_t n)
+	{
+		if(std::is_integral<T>::value) return a == b;
+		const double limit = double(std::numeric_limits<T>::epsilon()) * double(n + 1) * double(magnitude) * 4;
+		return std::fabs(double(a) - double(b)) <= limit;
+	}
+
+	template<class T> bool same(const T a, const T b){return a == b || (a != a && b != b);}
+
+	/* The position of the extremum like search<T, true>::min_element and max_element do it */
+	template<class T> size_t position(const simd::table<T> &k, const T *p, const size_t n, const bool minimum)
+	{
+		if(n == 0 || !(p[0] == p[0])) return 0;
+		const size_t i = k.find(p, n, minimum ? k.min(p, n) : k.max(p, n));
+		return i < n ? i : 0;
+	}
+
+	template<class T> void check(const char *isa, const simd::table<T> &k)
+	{
+		const char *type = typeid(T).name();
+		GT::iVector<T> a, b, r;
+		for(size_t n=0; n<=300; n++)
+			for(size_t offset=0; offset<4; offset++)
+			{
+				a.clear(); b.clear();
+				for(size_t i=0; i<n + offset; i++){a.push_back(random_value<T>()); b.push_back(random_value<T>());}
+				if(!std::is_integral<T>::value && n != 0 && n % 7 == 0)
+					a[offset + size_t(rng() % n)] = std::numeric_limits<T>::quiet_NaN();
+				const T *p = a.begin() + offset, *q = b.begin() + offset;
+
+				const T present = n != 0 ? p[size_t(rng() % n)] : T(1), absent = T(101);
+				if(k.find(p, n, present) != scalar_search::find(p, n, present)) fail(isa, type, "find", n, offset);
+				if(k.find(p, n, absent) != scalar_search::find(p, n, absent)) fail(isa, type, "find (absent)", n, offset);
+				if(k.count(p, n, present) != scalar_search::count(p, n, present)) fail(isa, type, "count", n, offset);
+				if(position(k, p, n, true) != scalar_search::min_element(p, n)) fail(isa, type, "min_element", n, offset);
+				if(position(k, p, n, false) != scalar_search::max_element(p, n)) fail(isa, type, "max_element", n, offset);
+
+				T magnitude = T(), products = T();
+				for(size_t i=0; i<n; i++){magnitude += T(p[i] < 0 ? -p[i] : p[i]); products += T(p[i] * q[i] < 0 ? -(p[i] * q[i]) : p[i] * q[i]);}
+				const T s = k.sum(p, n), d = k.dot(p, q, n);
+				if(!(same(s, scalar_search::sum(p, n)) || close(s, scalar_search::sum(p, n), magnitude, n))) fail(isa, type, "sum", n, offset);
+				if(!(same(d, scalar_search::dot(p, q, n)) || close(d, scalar_search::dot(p, q, n), products, n))) fail(isa, type, "dot", n, offset);
+
+				r = a;
+				k.reverse(r.begin() + offset, r.begin() + offset + n);
+				for(size_t i=0; i<n; i++)
+					if(!same(r[offset + i], p[n - 1 - i])){fail(isa, type, "reverse", n, offset); break;}
+			}
+	}
+
+	template<template<class> class ISA> void check_all(const char *isa)
+	{
+		check<int8_t>(isa, simd::make_table<int8_t, ISA>());
+		check<uint8_t>(isa, simd::make_table<uint8_t, ISA>());
+		check<int16_t>(isa, simd::make_table<int16_t, ISA>());
+		check<uint16_t>(isa, simd::make_table<uint16_t, ISA>());
+		check<int32_t>(isa, simd::make_table<int32_t, ISA>());
+		check<uint32_t>(isa, simd::make_table<uint32_t, ISA>());
+		check<int64_t>(isa, simd::make_table<int64_t, ISA>());
+		check<uint64_t>(isa, simd::make_table<uint64_t, ISA>());
+		check<float>(isa, simd::make_table<float, ISA>());
+		check<double>(isa, simd::make_table<double, ISA>());
+		std::printf("%s checked\n", isa);
+	}
+} // end of namespace
+
+int main()
+{
+	const simd::isa best = simd::cpu();
+	if(best >= simd::SSE2) check_all<simd::sse2>("SSE2");
+	if(best >= simd::AVX2) check_all<simd::avx2>("AVX2");
+	if(best >= simd::AVX512) check_all<simd::avx512>("AVX-512");
+	if(best == simd::NONE) std::printf("no SIMD kernels on this CPU, nothing to check\n");
+	std::printf(failures == 0 ? "all kernels match the loops\n" : "%zu FAILURES\n", failures);
+	return failures == 0 ? 0 : 1;
+}
+#else
+int main()
+{
+	std::printf("built without GT_HAS_SIMD, nothing to check\n");
+	return 0;
+}
+#endif